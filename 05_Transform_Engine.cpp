@@ -0,0 +1,660 @@
+/*
+=============================================================
+     MAPX TRANSFORM ENGINE - PERFORMANCE TUTORIAL
+     File: 05_Transform_Engine.cpp
+=============================================================
+Learn: const& inputs, reserve/resize, type-changing transforms,
+       vectorizable loops, thread pools, execution policies,
+       lazy fused pipelines
+
+The mapx in main5.cpp looks like this:
+
+    template <typename T, typename Func>
+    vector<T> mapx(vector<T> &v, Func f){
+        vector<T> res;
+        for(T i: v) res.push_back(f(i));
+        return res;
+    }
+
+Problems when mapping 100M elements:
+  - the result is never reserved, so push_back reallocates ~27 times
+  - every element is copied into "T i"
+  - the result type is forced to be T (int -> string is impossible)
+  - only one core is used
+This file rebuilds mapx as a small transform engine.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <iterator>
+#include <type_traits>
+#include <cstdlib>
+#include <numeric>
+#include <malloc.h>
+#include <atomic>
+#include <new>
+#include <cstddef>
+using namespace std;
+
+// ============= THREAD POOL =============
+
+/*
+A fixed set of worker threads waiting on a shared task queue.
+Creating threads is expensive, so we create them once and reuse them
+for every parallel mapx call.
+*/
+class ThreadPool {
+    private:
+        vector<thread> workers;
+        queue<function<void()>> tasks;
+        mutex mtx;
+        condition_variable cv;
+        bool stopping = false;
+
+    public:
+        explicit ThreadPool(size_t threads = thread::hardware_concurrency()) {
+            if (threads == 0) threads = 1;
+            for (size_t i = 0; i < threads; i++) {
+                workers.emplace_back([this] {
+                    while (true) {
+                        function<void()> task;
+                        {
+                            unique_lock<mutex> lock(mtx);
+                            cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                            if (stopping && tasks.empty()) return;
+                            task = move(tasks.front());
+                            tasks.pop();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                lock_guard<mutex> lock(mtx);
+                stopping = true;
+            }
+            cv.notify_all();
+            for (thread &t : workers) t.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const {
+            return workers.size();
+        }
+
+        // Runs body(begin, end) over [0, n) split into chunks of at least
+        // minChunk elements and waits until every chunk is finished.
+        // The calling thread works on the first chunk itself.
+        template <typename Body>
+        void parallelFor(size_t n, size_t minChunk, Body body) {
+            minChunk = max<size_t>(minChunk, 1);
+            size_t chunks = min(workers.size() + 1, (n + minChunk - 1) / minChunk);
+            if (chunks <= 1) {
+                body(size_t(0), n);
+                return;
+            }
+            // Chunk c is [c * n / chunks, (c + 1) * n / chunks): sizes differ
+            // by at most 1 and, since chunks <= n, none is empty
+            size_t pending = chunks - 1;
+            mutex doneMtx;
+            condition_variable doneCv;
+            {
+                lock_guard<mutex> lock(mtx);
+                for (size_t c = 1; c < chunks; c++) {
+                    size_t b = c * n / chunks, e = (c + 1) * n / chunks;
+                    tasks.push([&, b, e] {
+                        body(b, e);
+                        lock_guard<mutex> done(doneMtx);
+                        if (--pending == 0) doneCv.notify_one();
+                    });
+                }
+            }
+            cv.notify_all();
+            body(size_t(0), n / chunks);
+            unique_lock<mutex> lock(doneMtx);
+            doneCv.wait(lock, [&] { return pending == 0; });
+        }
+};
+
+// ============= EXECUTION POLICIES =============
+
+/*
+The caller picks how mapx runs by passing a policy object first:
+    mapx(arr, f)                 -> sequential (default)
+    mapx(Sequential{}, arr, f)   -> sequential
+    mapx(Parallel{pool}, arr, f) -> split across the pool
+Parallel is opt-in because small inputs are faster on one thread.
+*/
+struct Sequential {};
+
+struct Parallel {
+    ThreadPool &pool;
+    size_t minChunk = 1 << 16;  // Don't hand out chunks smaller than 64K elements
+};
+
+// ============= CONTIGUOUS KERNEL =============
+
+/*
+The hot loop. Raw pointers + __restrict tell the compiler the input and
+output never overlap, so a simple f like x*x compiles to SIMD code.
+*/
+template <typename T, typename U, typename Func>
+inline void mapKernel(const T *__restrict in, U *__restrict out, size_t n, Func &f) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = f(in[i]);
+    }
+}
+
+// In-place variant: in and out are the same buffer, so no __restrict
+template <typename T, typename Func>
+inline void mapKernelInPlace(T *data, size_t n, Func &f) {
+    for (size_t i = 0; i < n; i++) {
+        data[i] = f(data[i]);
+    }
+}
+
+// ============= MAPX: VECTOR -> NEW VECTOR =============
+
+// Result element type: whatever Func returns (int -> string is allowed)
+template <typename T, typename Func>
+using MapResult = decay_t<invoke_result_t<Func&, const T&>>;
+
+template <typename T, typename Func, typename U = MapResult<T, Func>>
+vector<U> mapx(Sequential, const vector<T> &v, Func f) {
+    vector<U> res;
+    if constexpr (is_default_constructible_v<U> && is_trivially_copyable_v<U>) {
+        // Size once, then write through raw pointers (vectorizable)
+        res.resize(v.size());
+        mapKernel(v.data(), res.data(), v.size(), f);
+    } else {
+        // Non-trivial results (e.g. string): reserve once, construct in place
+        res.reserve(v.size());
+        for (const T &x : v) res.emplace_back(f(x));
+    }
+    return res;
+}
+
+template <typename T, typename Func, typename U = MapResult<T, Func>>
+vector<U> mapx(Parallel p, const vector<T> &v, Func f) {
+    // Parallel writes need every slot to exist up front
+    static_assert(is_default_constructible_v<U>, "parallel mapx needs a default-constructible result type");
+    vector<U> res(v.size());
+    const T *in = v.data();
+    U *out = res.data();
+    p.pool.parallelFor(v.size(), p.minChunk, [&](size_t b, size_t e) {
+        Func local = f;  // Each chunk gets its own copy of the functor
+        mapKernel(in + b, out + b, e - b, local);
+    });
+    return res;
+}
+
+// Default policy is sequential, so old code like mapx(arr, f) keeps working
+template <typename T, typename Func>
+auto mapx(const vector<T> &v, Func f) {
+    return mapx(Sequential{}, v, f);
+}
+
+// ============= MAPX: IN PLACE =============
+
+/*
+arr = mapx(arr, f) allocates a second array and throws the first away.
+When the type doesn't change we can overwrite the input instead.
+*/
+template <typename T, typename Func>
+void mapx_inplace(Sequential, vector<T> &v, Func f) {
+    mapKernelInPlace(v.data(), v.size(), f);
+}
+
+template <typename T, typename Func>
+void mapx_inplace(Parallel p, vector<T> &v, Func f) {
+    T *data = v.data();
+    p.pool.parallelFor(v.size(), p.minChunk, [&](size_t b, size_t e) {
+        Func local = f;
+        mapKernelInPlace(data + b, e - b, local);
+    });
+}
+
+template <typename T, typename Func>
+void mapx_inplace(vector<T> &v, Func f) {
+    mapx_inplace(Sequential{}, v, f);
+}
+
+// ============= MAPX: OUTPUT ITERATOR =============
+
+/*
+Same shape as std::transform: read [first, last), write to out.
+Useful for appending into an existing container (back_inserter) or
+writing into a pre-sized buffer you already own.
+*/
+
+// Iterators whose elements live in one contiguous block: raw pointers and
+// vector iterators (C++17 has no contiguous_iterator concept yet)
+// (vector<bool> packs bits and back_inserter has value_type void, so both
+// fall back to the plain loop)
+template <typename It, typename V = typename iterator_traits<It>::value_type, typename = void>
+struct IsContiguous : bool_constant<is_pointer_v<It>> {};
+
+template <typename It, typename V>
+struct IsContiguous<It, V, enable_if_t<!is_void_v<V> && !is_same_v<V, bool>>>
+    : bool_constant<is_pointer_v<It> ||
+                    is_same_v<It, typename vector<V>::iterator> ||
+                    is_same_v<It, typename vector<V>::const_iterator>> {};
+
+template <typename InIt, typename OutIt, typename Func>
+OutIt mapx(Sequential, InIt first, InIt last, OutIt out, Func f) {
+    if constexpr (IsContiguous<InIt>::value && IsContiguous<OutIt>::value) {
+        // Both sides contiguous: run the raw-pointer kernel
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return out;
+        auto *in = &*first;
+        auto *dst = &*out;
+        if (static_cast<const void*>(dst) == static_cast<const void*>(in)) {
+            // out == first is allowed (as in std::transform), but then the
+            // __restrict promise of mapKernel would be false
+            if constexpr (is_same_v<remove_cv_t<remove_pointer_t<decltype(in)>>, remove_pointer_t<decltype(dst)>>) {
+                mapKernelInPlace(dst, n, f);
+            } else {
+                for (size_t i = 0; i < n; i++) dst[i] = f(in[i]);
+            }
+        } else {
+            mapKernel(in, dst, n, f);
+        }
+        return out + static_cast<ptrdiff_t>(n);
+    } else {
+        for (; first != last; ++first, ++out) {
+            *out = f(*first);
+        }
+        return out;
+    }
+}
+
+template <typename InIt, typename OutIt, typename Func>
+OutIt mapx(Parallel p, InIt first, InIt last, OutIt out, Func f) {
+    static_assert(is_base_of_v<random_access_iterator_tag, typename iterator_traits<InIt>::iterator_category> &&
+                  is_base_of_v<random_access_iterator_tag, typename iterator_traits<OutIt>::iterator_category>,
+                  "parallel mapx needs random-access iterators (no back_inserter)");
+    size_t n = static_cast<size_t>(last - first);
+    p.pool.parallelFor(n, p.minChunk, [&](size_t b, size_t e) {
+        mapx(Sequential{}, first + static_cast<ptrdiff_t>(b), first + static_cast<ptrdiff_t>(e),
+             out + static_cast<ptrdiff_t>(b), f);
+    });
+    return out + static_cast<ptrdiff_t>(n);
+}
+
+template <typename InIt, typename OutIt, typename Func,
+          typename = enable_if_t<!is_same_v<decay_t<InIt>, Sequential> && !is_same_v<decay_t<InIt>, Parallel>>>
+OutIt mapx(InIt first, InIt last, OutIt out, Func f) {
+    return mapx(Sequential{}, first, last, out, f);
+}
+
+// ============= LAZY PIPELINE =============
+
+/*
+Chaining eager calls builds a full vector per stage:
+
+    auto a = mapx(arr, f);      // n elements
+    auto b = mapx(a, g);        // another n elements
+    ... filter, then reduce
+
+A Pipeline stores the stages instead of running them. Nothing happens
+until a terminal operation (reduce, collect, forEach, count) runs, and
+then every stage is applied to one element before moving to the next,
+all inside a single loop over the source.
+
+Internally a pipeline is a "generator": a function that takes a sink and
+calls sink(value) for each element. The sink returns false to stop early
+(that is how take() ends the loop).
+*/
+template <typename T, typename Gen>
+class Pipeline {
+    private:
+        Gen gen;
+
+    public:
+        explicit Pipeline(Gen g) : gen(move(g)) {}
+
+        // ----- Stages (return a new, longer pipeline) -----
+
+        template <typename Func>
+        auto mapx(Func f) const {
+            using U = MapResult<T, Func>;
+            auto next = [src = gen, f](auto &&sink) {
+                return src([&](const T &x) { return sink(f(x)); });
+            };
+            return Pipeline<U, decltype(next)>(move(next));
+        }
+
+        template <typename Pred>
+        auto filter(Pred p) const {
+            auto next = [src = gen, p](auto &&sink) {
+                return src([&](const T &x) { return p(x) ? sink(x) : true; });
+            };
+            return Pipeline<T, decltype(next)>(move(next));
+        }
+
+        auto take(size_t count) const {
+            auto next = [src = gen, count](auto &&sink) {
+                size_t left = count;  // Fresh counter for every run
+                if (left == 0) return false;
+                return src([&](const T &x) { return sink(x) && --left != 0; });
+            };
+            return Pipeline<T, decltype(next)>(move(next));
+        }
+
+        // ----- Terminal operations (run the fused loop) -----
+
+        template <typename Acc, typename Op>
+        Acc reduce(Acc init, Op op) const {
+            gen([&](const T &x) {
+                init = op(move(init), x);
+                return true;
+            });
+            return init;
+        }
+
+        template <typename Func>
+        void forEach(Func f) const {
+            gen([&](const T &x) {
+                f(x);
+                return true;
+            });
+        }
+
+        size_t count() const {
+            return reduce(size_t(0), [](size_t c, const T &) { return c + 1; });
+        }
+
+        vector<T> collect() const {
+            vector<T> res;
+            gen([&](const T &x) {
+                res.push_back(x);
+                return true;
+            });
+            return res;
+        }
+};
+
+// Start a pipeline over an existing vector (no copy: the vector must outlive it)
+template <typename T>
+auto lazy(const vector<T> &v) {
+    auto gen = [&v](auto &&sink) {
+        for (const T &x : v) {
+            if (!sink(x)) return false;
+        }
+        return true;
+    };
+    return Pipeline<T, decltype(gen)>(move(gen));
+}
+
+// ============= ALLOCATION TRACKING =============
+
+/*
+Replacing the global operator new lets the benchmark report how many bytes
+are live at the peak. Blocks come straight from malloc; the allocator
+itself reports each block's size (usable size, which can be a few bytes
+more than requested), so new and delete count the same amount.
+
+noinline: inlined into a vector destructor, GCC sees free() on memory
+from operator new and warns (-Wmismatched-new-delete), though the pair
+matches once both are replaced.
+*/
+struct AllocStats {
+    static inline atomic<size_t> current{0};
+    static inline atomic<size_t> peak{0};
+
+    static void resetPeak() {
+        peak = current.load();
+    }
+
+    static size_t blockSize(void *p) {
+#ifdef _WIN32
+        return _msize(p);
+#else
+        return malloc_usable_size(p);
+#endif
+    }
+};
+
+__attribute__((noinline)) void *operator new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    size_t now = AllocStats::current += AllocStats::blockSize(p);
+    size_t seen = AllocStats::peak.load();
+    while (now > seen && !AllocStats::peak.compare_exchange_weak(seen, now)) {}
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept {
+    if (p) AllocStats::current -= AllocStats::blockSize(p);
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    operator delete(p);
+}
+
+// ============= BENCHMARK =============
+
+// The original mapx from main5.cpp, kept for comparison
+template <typename T, typename Func>
+vector<T> mapxOriginal(vector<T> &v, Func f) {
+    vector<T> res;
+    for (T i : v) {
+        res.push_back(f(i));
+    }
+    return res;
+}
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void benchmark(size_t n, ThreadPool &pool) {
+    vector<int> arr(n);
+    for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(i & 1023);
+    auto square = [](int x) { return x * x + 1; };
+    long long check = 0;
+
+    double tOriginal = timeMs([&] { check += mapxOriginal(arr, square).back(); });
+
+    double tTransform = timeMs([&] {
+        vector<int> out(n);
+        transform(arr.begin(), arr.end(), out.begin(), square);
+        check += out.back();
+    });
+
+    double tSeq = timeMs([&] { check += mapx(arr, square).back(); });
+
+    double tPar = timeMs([&] { check += mapx(Parallel{pool}, arr, square).back(); });
+
+    vector<int> copy = arr;
+    double tInPlace = timeMs([&] {
+        mapx_inplace(Parallel{pool}, copy, square);
+        check += copy.back();
+    });
+
+    cout << n << " elements (checksum " << check << ")\n";
+    cout << "  original mapx     : " << tOriginal << " ms\n";
+    cout << "  std::transform    : " << tTransform << " ms\n";
+    cout << "  mapx (sequential) : " << tSeq << " ms\n";
+    cout << "  mapx (parallel)   : " << tPar << " ms\n";
+    cout << "  mapx_inplace (par): " << tInPlace << " ms\n";
+}
+
+// Peak extra memory (MB) used while running body
+template <typename Body>
+double peakMB(Body body) {
+    size_t before = AllocStats::current;
+    AllocStats::resetPeak();
+    body();
+    return double(AllocStats::peak - before) / (1024.0 * 1024.0);
+}
+
+void benchmarkPipeline(size_t n) {
+    vector<int> arr(n);
+    for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(i % 1000);
+    auto plusOne = [](int x) { return x + 1; };
+    auto square = [](int x) { return static_cast<long long>(x) * x; };
+    auto isEven = [](long long x) { return x % 2 == 0; };
+    auto add = [](long long acc, long long x) { return acc + x; };
+    long long eager = 0, fused = 0;
+    double tEager = 0, tLazy = 0;
+
+    double mEager = peakMB([&] {
+        tEager = timeMs([&] {
+            vector<int> a = mapx(arr, plusOne);
+            vector<long long> b = mapx(a, square);
+            vector<long long> c;
+            copy_if(b.begin(), b.end(), back_inserter(c), isEven);
+            eager = accumulate(c.begin(), c.end(), 0LL, add);
+        });
+    });
+
+    double mLazy = peakMB([&] {
+        tLazy = timeMs([&] {
+            fused = lazy(arr).mapx(plusOne).mapx(square).filter(isEven).reduce(0LL, add);
+        });
+    });
+
+    cout << n << " elements (results " << (eager == fused ? "match" : "DIFFER") << ")\n";
+    cout << "  eager mapx chain : " << tEager << " ms, peak " << mEager << " MB\n";
+    cout << "  fused pipeline   : " << tLazy << " ms, peak " << mLazy << " MB\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  MAPX TRANSFORM ENGINE\n";
+    cout << "========================================\n";
+
+    // ===== BASIC USAGE (same call as main5.cpp) =====
+    cout << "\n--- mapx(arr, f) ---\n";
+    vector<int> arr = {1, 2, 3, 4};
+    arr = mapx(arr, [](int x) { return x * x; });
+    for (int i : arr) cout << i << " ";
+    cout << "\n";
+
+    // ===== TYPE-CHANGING RESULT =====
+    cout << "\n--- int -> string ---\n";
+    vector<string> words = mapx(arr, [](int x) { return "#" + to_string(x); });
+    for (const string &w : words) cout << w << " ";
+    cout << "\n";
+
+    // ===== IN PLACE =====
+    cout << "\n--- mapx_inplace ---\n";
+    mapx_inplace(arr, [](int x) { return x + 100; });
+    for (int i : arr) cout << i << " ";
+    cout << "\n";
+
+    // ===== OUTPUT ITERATOR =====
+    cout << "\n--- output iterator ---\n";
+    vector<double> halves;
+    mapx(arr.begin(), arr.end(), back_inserter(halves), [](int x) { return x / 2.0; });
+    for (double d : halves) cout << d << " ";
+    cout << "\n";
+    vector<int> negated(arr.size());
+    mapx(arr.begin(), arr.end(), negated.begin(), [](int x) { return -x; });  // contiguous fast path
+    for (int i : negated) cout << i << " ";
+    cout << "\n";
+    mapx(negated.begin(), negated.end(), negated.begin(), [](int x) { return x * 2; });  // out == first
+    for (int i : negated) cout << i << " ";
+    cout << "\n";
+
+    // ===== PARALLEL =====
+    ThreadPool pool;
+    cout << "\n--- parallel (" << pool.size() << " worker threads) ---\n";
+    vector<long long> big(1000000);
+    for (size_t i = 0; i < big.size(); i++) big[i] = static_cast<long long>(i);
+    vector<long long> doubled = mapx(Parallel{pool}, big, [](long long x) { return 2 * x; });
+    cout << "doubled[999999] = " << doubled[999999] << "\n";
+
+    // Fewer elements than threads, one element per chunk at least
+    ThreadPool three(3);
+    vector<int> five = {1, 2, 3, 4, 5};
+    for (int i : mapx(Parallel{three, 1}, five, [](int x) { return x * 10; })) cout << i << " ";
+    cout << "\n";
+
+    // ===== BENCHMARK =====
+    // Pass a max size on the command line to go up to 1B: ./transform 1000000000
+    cout << "\n--- BENCHMARK vs std::transform ---\n";
+    size_t maxN = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    for (size_t n = 1000000; n <= maxN; n *= 10) {
+        benchmark(n, pool);
+    }
+
+    // ===== LAZY PIPELINE =====
+    cout << "\n--- lazy pipeline ---\n";
+    vector<int> nums = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    auto evenSquares = lazy(nums)
+        .mapx([](int x) { return x * x; })
+        .filter([](int x) { return x % 2 == 0; });  // Nothing has run yet
+    for (int x : evenSquares.take(3).collect()) cout << x << " ";
+    cout << "\n";
+    cout << "sum of even squares = " << evenSquares.reduce(0, [](int a, int b) { return a + b; }) << "\n";
+
+    cout << "\n--- BENCHMARK: eager mapx chain vs fused pipeline ---\n";
+    for (size_t n = 1000000; n <= maxN; n *= 10) {
+        benchmarkPipeline(n);
+    }
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. PASS BY CONST REFERENCE:
+   - mapx(const vector<T> &v, ...) never copies the input
+   - Loop with "const T &x", not "T x", to avoid per-element copies
+
+2. ALLOCATE ONCE:
+   - resize()/reserve() the result before the loop
+   - push_back on an empty vector reallocates O(log n) times
+
+3. TYPE-CHANGING TRANSFORMS:
+   - invoke_result_t<Func, T> gives the return type of f
+   - mapx(vector<int>, int -> string) returns vector<string>
+
+4. VECTORIZATION:
+   - Tight loops over raw pointers with __restrict auto-vectorize at -O2/-O3
+   - Iterators that are not contiguous (back_inserter, list) use a plain loop
+
+5. EXECUTION POLICIES:
+   - Sequential{} / Parallel{pool} select the implementation at compile time
+   - Parallel splits [0, n) into chunks and runs them on a ThreadPool
+   - Only worth it for large inputs; minChunk keeps chunks big
+
+6. LAZY PIPELINES (FUSION):
+   - lazy(v).mapx(f).filter(p).take(k) only records the stages
+   - reduce/collect/forEach/count run ONE loop over the source
+   - No temporary vectors: peak memory stays flat as stages are added
+   - take(k) stops the loop early, so the rest of the input is never read
+
+COMPILATION:
+    g++ -std=c++17 -O3 -march=native -pthread 05_Transform_Engine.cpp -o transform && ./transform
+    ./transform 1000000000   (benchmark up to 1B elements, needs ~12GB RAM)
+
+NEXT STEP: Split strings without copying (06_String_Split.cpp)!
+*/
@@ -0,0 +1,762 @@
+/*
+=============================================================
+     ZERO-COPY STRING SPLIT - PERFORMANCE TUTORIAL
+     File: 06_String_Split.cpp
+=============================================================
+Learn: string_view, lazy iterators, SIMD byte scanning,
+       runtime CPU dispatch, memory-mapped and chunked file streaming
+
+The split in main6.cpp (commented out) looks like this:
+
+    vector<string> split(string s, char c){
+        vector<string> res;
+        string tmp;
+        for(char ch: s){
+            if(ch == c){ res.push_back(tmp); tmp = ""; }
+            else tmp += ch;
+        }
+        ...
+    }
+
+Problems on multi-GB input:
+  - s is passed by value (the whole input is copied once)
+  - tmp grows one char at a time (many small reallocations)
+  - every token becomes a new heap string
+  - delimiters are found one byte at a time
+This file revives split so that tokens are string_view slices that point
+into the original buffer, and delimiters are found 16/32 bytes at a time.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <fstream>
+#include <cstdio>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPLIT_HAVE_MMAP 1
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SPLIT_HAVE_X86 1
+#endif
+using namespace std;
+
+// ============= SCALAR SCANNERS =============
+
+/*
+Every scanner has the same contract: return a pointer to the first byte in
+[p, end) that matches, or end if there is none.
+*/
+const char* findCharScalar(const char *p, const char *end, char c) {
+    for (; p < end; p++) {
+        if (*p == c) return p;
+    }
+    return end;
+}
+
+const char* findAnyScalar(const char *p, const char *end, const char *set, size_t setLen) {
+    bool table[256] = {};
+    for (size_t i = 0; i < setLen; i++) table[static_cast<unsigned char>(set[i])] = true;
+    for (; p < end; p++) {
+        if (table[static_cast<unsigned char>(*p)]) return p;
+    }
+    return end;
+}
+
+// ============= SIMD SCANNERS (x86) =============
+
+/*
+SIMD idea: load 16 (SSE2) or 32 (AVX2) bytes, compare all of them against
+the delimiter at once, and turn the result into a bitmask with movemask.
+The lowest set bit is the first match. Any leftover tail (< 16 bytes) is
+handled by the scalar loop.
+
+SSE2 is part of every x86-64 CPU. AVX2 is not, so its functions are
+compiled with target("avx2") and only called if the CPU reports support.
+*/
+#ifdef SPLIT_HAVE_X86
+
+const char* findCharSSE2(const char *p, const char *end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+    return findCharScalar(p, end, c);
+}
+
+__attribute__((target("avx2")))
+const char* findCharAVX2(const char *p, const char *end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    for (; end - p >= 32; p += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return findCharSSE2(p, end, c);
+}
+
+// Any-of: compare the block against each delimiter and OR the results.
+// Cheap for the usual small sets like " \t" or ",;|".
+const char* findAnySSE2(const char *p, const char *end, const char *set, size_t setLen) {
+    if (setLen > 16) return findAnyScalar(p, end, set, setLen);
+    __m128i needles[16];
+    for (size_t i = 0; i < setLen; i++) needles[i] = _mm_set1_epi8(set[i]);
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_setzero_si128();
+        for (size_t i = 0; i < setLen; i++) hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[i]));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+    return findAnyScalar(p, end, set, setLen);
+}
+
+__attribute__((target("avx2")))
+const char* findAnyAVX2(const char *p, const char *end, const char *set, size_t setLen) {
+    if (setLen > 16) return findAnyScalar(p, end, set, setLen);
+    __m256i needles[16];
+    for (size_t i = 0; i < setLen; i++) needles[i] = _mm256_set1_epi8(set[i]);
+    for (; end - p >= 32; p += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_setzero_si256();
+        for (size_t i = 0; i < setLen; i++) hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, needles[i]));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+    return findAnySSE2(p, end, set, setLen);
+}
+
+#endif
+
+// ============= RUNTIME DISPATCH =============
+
+/*
+Pick the best scanner once, the first time it is needed. After that every
+call is a plain function-pointer call.
+*/
+struct Scanner {
+    const char* (*findChar)(const char*, const char*, char);
+    const char* (*findAny)(const char*, const char*, const char*, size_t);
+    const char *name;
+};
+
+const Scanner& scanner() {
+    static const Scanner best = [] {
+#ifdef SPLIT_HAVE_X86
+        if (__builtin_cpu_supports("avx2")) return Scanner{findCharAVX2, findAnyAVX2, "AVX2"};
+        return Scanner{findCharSSE2, findAnySSE2, "SSE2"};
+#else
+        return Scanner{findCharScalar, findAnyScalar, "scalar"};
+#endif
+    }();
+    return best;
+}
+
+// ============= DELIMITERS =============
+
+/*
+A delimiter knows how to find its next occurrence and how long it is.
+find() returns a pointer to the start of the match (or end).
+*/
+
+// Single character: split(s, ',')
+struct CharDelim {
+    char c;
+
+    const char* find(const char *p, const char *end) const {
+        return scanner().findChar(p, end, c);
+    }
+    size_t length() const {
+        return 1;
+    }
+};
+
+// Multi-character: split(s, Str("::")) or split(s, Str(", "))
+struct StrDelim {
+    string_view pattern;
+
+    // Scan for the first byte with SIMD, then confirm the rest with memcmp
+    const char* find(const char *p, const char *end) const {
+        if (pattern.empty()) return end;  // Empty delimiter: whole input is one token
+        size_t n = pattern.size();
+        while (static_cast<size_t>(end - p) >= n) {
+            p = scanner().findChar(p, end - n + 1, pattern[0]);
+            if (p == end - n + 1) return end;
+            if (memcmp(p + 1, pattern.data() + 1, n - 1) == 0) return p;
+            p++;
+        }
+        return end;
+    }
+    size_t length() const {
+        return pattern.size();
+    }
+};
+
+// Any one of a set of characters: split(s, AnyOf(" \t"))
+struct AnyOfDelim {
+    string_view set;
+
+    const char* find(const char *p, const char *end) const {
+        return scanner().findAny(p, end, set.data(), set.size());
+    }
+    size_t length() const {
+        return 1;
+    }
+};
+
+inline StrDelim Str(string_view pattern) {
+    return StrDelim{pattern};
+}
+
+inline AnyOfDelim AnyOf(string_view set) {
+    return AnyOfDelim{set};
+}
+
+inline CharDelim toDelim(char c) {
+    return CharDelim{c};
+}
+
+template <typename Delim>
+inline Delim toDelim(Delim d) {
+    return d;
+}
+
+// ============= LAZY SPLIT =============
+
+/*
+SplitRange finds one token per ++, so you can stop early and nothing is
+allocated. Every field is produced, including empty ones between two
+delimiters in a row (so "a,,b" gives "a", "", "b" and the field count is
+stable for CSV-like data). Pass skipEmpty = true to drop them.
+
+The tokens point into the source, so the source must outlive them.
+*/
+template <typename Delim>
+class SplitRange {
+    private:
+        string_view src;
+        Delim delim;
+        bool skipEmpty;
+
+    public:
+        SplitRange(string_view s, Delim d, bool skip) : src(s), delim(d), skipEmpty(skip) {}
+
+        class iterator {
+            private:
+                const SplitRange *range = nullptr;  // nullptr means end()
+                const char *tokBegin = nullptr;
+                const char *tokEnd = nullptr;
+
+                void findToken(const char *from) {
+                    const char *end = range->src.data() + range->src.size();
+                    while (true) {
+                        tokBegin = from;
+                        tokEnd = range->delim.find(from, end);
+                        if (!range->skipEmpty || tokEnd != tokBegin) return;
+                        if (tokEnd == end) {  // Only empty fields left
+                            range = nullptr;
+                            return;
+                        }
+                        from = tokEnd + range->delim.length();
+                    }
+                }
+
+            public:
+                using iterator_category = forward_iterator_tag;
+                using value_type = string_view;
+                using difference_type = ptrdiff_t;
+                using pointer = const string_view*;
+                using reference = string_view;
+
+                iterator() = default;
+
+                explicit iterator(const SplitRange *r) : range(r) {
+                    findToken(r->src.data());
+                }
+
+                string_view operator*() const {
+                    return string_view(tokBegin, static_cast<size_t>(tokEnd - tokBegin));
+                }
+
+                iterator& operator++() {
+                    const char *end = range->src.data() + range->src.size();
+                    if (tokEnd == end) range = nullptr;  // That was the last field
+                    else findToken(tokEnd + range->delim.length());
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator old = *this;
+                    ++*this;
+                    return old;
+                }
+
+                bool operator==(const iterator &o) const {
+                    return range == o.range && (range == nullptr || tokBegin == o.tokBegin);
+                }
+                bool operator!=(const iterator &o) const {
+                    return !(*this == o);
+                }
+        };
+
+        iterator begin() const {
+            return iterator(this);
+        }
+        iterator end() const {
+            return iterator();
+        }
+};
+
+// Lazy form: for (string_view tok : split(line, ' ')) { ... }
+template <typename D>
+auto split(string_view s, D delim, bool skipEmpty = false) {
+    auto d = toDelim(delim);
+    return SplitRange<decltype(d)>(s, d, skipEmpty);
+}
+
+// ============= EAGER SPLIT =============
+
+/*
+Eager form: fills a vector the caller owns. Reusing the same vector for
+every line means its capacity is allocated once for the whole file.
+Returns the number of tokens written.
+*/
+template <typename D>
+size_t split(string_view s, D delim, vector<string_view> &out, bool skipEmpty = false) {
+    auto d = toDelim(delim);
+    out.clear();
+    const char *p = s.data();
+    const char *end = p + s.size();
+    while (true) {
+        const char *hit = d.find(p, end);
+        if (!skipEmpty || hit != p) out.emplace_back(p, static_cast<size_t>(hit - p));
+        if (hit == end) break;
+        p = hit + d.length();
+    }
+    return out.size();
+}
+
+// ============= STREAMING: MEMORY-MAPPED FILES =============
+
+/*
+getline(cin, s) + split only ever sees one line that has already been
+copied into a std::string. For whole files we can do better:
+
+mmap asks the OS to make the file appear in memory. Pages are loaded on
+first touch, nothing is copied into our own buffers, and the whole file
+is one string_view, so split() works on it directly and every token
+points straight into the page cache.
+
+Only available on POSIX systems (Linux/macOS). Elsewhere open() returns
+false and the chunked reader below is used instead.
+*/
+class MappedFile {
+    private:
+        const char *data = nullptr;
+        size_t size = 0;
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+            close();
+        }
+
+        bool open(const string &path) {
+            close();
+#ifdef SPLIT_HAVE_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                return false;
+            }
+            size = static_cast<size_t>(st.st_size);
+            if (size == 0) {  // mmap of length 0 fails; an empty view is fine
+                ::close(fd);
+                data = "";
+                return true;
+            }
+            void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // The mapping stays valid after the descriptor is closed
+            if (p == MAP_FAILED) {
+                size = 0;
+                return false;
+            }
+            madvise(p, size, MADV_SEQUENTIAL);  // Hint: read ahead aggressively
+            data = static_cast<const char*>(p);
+            return true;
+#else
+            (void)path;
+            return false;
+#endif
+        }
+
+        void close() {
+#ifdef SPLIT_HAVE_MMAP
+            if (data && size > 0) munmap(const_cast<char*>(data), size);
+#endif
+            data = nullptr;
+            size = 0;
+        }
+
+        string_view view() const {
+            return string_view(data ? data : "", size);
+        }
+};
+
+// ============= STREAMING: CHUNKED READER =============
+
+/*
+Reads the file in large blocks (4 MB by default) into one reusable buffer
+and hands out records as string_views into that buffer.
+
+A record that straddles two blocks is handled by moving the unfinished
+tail to the front of the buffer before reading the next block, so the
+record is contiguous again. If one record is bigger than the whole
+buffer, the buffer doubles.
+
+Views returned by next() are only valid until the following call.
+*/
+class ChunkedReader {
+    private:
+        FILE *file = nullptr;
+        vector<char> buf;
+        size_t pos = 0;       // Start of the next record
+        size_t scanned = 0;   // Bytes after pos already known to have no delimiter
+        size_t filled = 0;    // Valid bytes in buf
+        bool eof = false;
+        char recordDelim;
+
+    public:
+        // chunkBytes is clamped to 1: an empty buffer could never be filled
+        explicit ChunkedReader(char delim = '\n', size_t chunkBytes = 4 << 20)
+            : buf(max<size_t>(chunkBytes, 1)), recordDelim(delim) {}
+
+        ChunkedReader(const ChunkedReader&) = delete;
+        ChunkedReader& operator=(const ChunkedReader&) = delete;
+
+        ~ChunkedReader() {
+            if (file) fclose(file);
+        }
+
+        bool open(const string &path) {
+            if (file) fclose(file);
+            file = fopen(path.c_str(), "rb");
+            pos = scanned = filled = 0;
+            eof = false;
+            return file != nullptr;
+        }
+
+        bool next(string_view &record) {
+            while (true) {
+                const char *begin = buf.data() + pos;
+                const char *end = buf.data() + filled;
+                const char *hit = scanner().findChar(begin + scanned, end, recordDelim);
+                if (hit != end) {
+                    record = string_view(begin, static_cast<size_t>(hit - begin));
+                    pos += record.size() + 1;
+                    scanned = 0;
+                    return true;
+                }
+                scanned = filled - pos;
+                if (eof) {
+                    if (pos == filled) return false;
+                    record = string_view(begin, filled - pos);  // Last line without '\n'
+                    pos = filled;
+                    scanned = 0;
+                    return true;
+                }
+                // Keep the unfinished record, then top the buffer up
+                memmove(buf.data(), begin, filled - pos);
+                filled -= pos;
+                pos = 0;
+                if (filled == buf.size()) buf.resize(buf.size() * 2);
+                size_t got = fread(buf.data() + filled, 1, buf.size() - filled, file);
+                filled += got;
+                if (got == 0) eof = true;
+            }
+        }
+};
+
+// ============= STREAMING: FILE TOKENIZER =============
+
+/*
+tokenizeFile() is the streaming version of getline + split: it walks every
+record (line) of a file, splits it into fields, and calls
+onRecord(const vector<string_view> &fields) for each one.
+
+The fields vector is reused for every record, so steady state does no
+allocation at all. Returns the number of records, or -1 if the file could
+not be opened.
+*/
+enum class ReadMode { Auto, Mmap, Chunked };
+
+template <typename D, typename OnRecord>
+long long tokenizeFile(const string &path, D fieldDelim, OnRecord onRecord, ReadMode mode = ReadMode::Auto) {
+    vector<string_view> fields;
+    long long records = 0;
+
+    if (mode != ReadMode::Chunked) {
+        MappedFile mapped;
+        if (mapped.open(path)) {
+            string_view all = mapped.view();
+            // Same rule as getline and ChunkedReader: every '\n' ends one
+            // record, so "a\n" is 1 record, "\n" is 1 empty record and only
+            // an empty file has none
+            if (all.empty()) return 0;
+            if (all.back() == '\n') all.remove_suffix(1);
+            for (string_view line : split(all, '\n')) {
+                split(line, fieldDelim, fields);
+                onRecord(static_cast<const vector<string_view>&>(fields));
+                records++;
+            }
+            return records;
+        }
+        if (mode == ReadMode::Mmap) return -1;
+    }
+
+    ChunkedReader reader('\n');
+    if (!reader.open(path)) return -1;
+    string_view line;
+    while (reader.next(line)) {
+        split(line, fieldDelim, fields);
+        onRecord(static_cast<const vector<string_view>&>(fields));
+        records++;
+    }
+    return records;
+}
+
+// ============= BENCHMARK =============
+
+// The split from main6.cpp, kept for comparison
+vector<string> splitOriginal(string s, char c) {
+    vector<string> res;
+    string tmp;
+    for (char ch : s) {
+        if (ch == c) {
+            res.push_back(tmp);
+            tmp = "";
+        } else tmp += ch;
+    }
+    if (tmp.length() > 0) res.push_back(tmp);
+    return res;
+}
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Fake log line: words of random length separated by spaces
+string makeLogLine(size_t bytes) {
+    string s;
+    s.reserve(bytes);
+    unsigned seed = 12345;
+    while (s.size() < bytes) {
+        seed = seed * 1103515245u + 12345u;
+        size_t len = 4 + (seed >> 16) % 40;
+        for (size_t i = 0; i < len && s.size() < bytes; i++) s += static_cast<char>('a' + (i * 7 + seed) % 26);
+        if (s.size() < bytes) s += ' ';
+    }
+    return s;
+}
+
+void benchmark(size_t bytes) {
+    string line = makeLogLine(bytes);
+    double mb = double(bytes) / (1024.0 * 1024.0);
+    size_t count = 0, tokenBytes = 0;
+    vector<string_view> tokens;
+
+    double tOriginal = timeMs([&] { count = splitOriginal(line, ' ').size(); });
+    size_t expected = count;
+
+    split(line, ' ', tokens);  // First call sizes the vector; later calls reuse it
+    double tEager = timeMs([&] { count = split(line, ' ', tokens); });
+    bool ok = count == expected;
+
+    double tLazy = timeMs([&] {
+        count = 0;
+        for (string_view tok : split(line, ' ')) {
+            count++;
+            tokenBytes += tok.size();
+        }
+    });
+    ok = ok && count == expected;
+
+    double tScalar = timeMs([&] {
+        const char *p = line.data(), *end = p + line.size();
+        count = 0;
+        while (true) {
+            const char *hit = findCharScalar(p, end, ' ');
+            count++;
+            if (hit == end) break;
+            p = hit + 1;
+        }
+    });
+    ok = ok && count == expected;
+
+    ok = ok && tokenBytes + expected - 1 == line.size();
+
+    cout << mb << " MB, " << expected << " tokens" << (ok ? "" : " (COUNT MISMATCH)") << "\n";
+    cout << "  original split    : " << tOriginal << " ms (" << mb / tOriginal * 1000 << " MB/s)\n";
+    cout << "  scalar scan       : " << tScalar << " ms (" << mb / tScalar * 1000 << " MB/s)\n";
+    cout << "  eager (reused vec): " << tEager << " ms (" << mb / tEager * 1000 << " MB/s)\n";
+    cout << "  lazy string_view  : " << tLazy << " ms (" << mb / tLazy * 1000 << " MB/s)\n";
+}
+
+// Writes a CSV-like file: 8 comma-separated fields per line
+void writeTestFile(const string &path, size_t bytes) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) return;
+    string line;
+    size_t written = 0;
+    unsigned seed = 99;
+    while (written < bytes) {
+        line.clear();
+        for (int field = 0; field < 8; field++) {
+            seed = seed * 1103515245u + 12345u;
+            if (field) line += ',';
+            line += to_string(seed % 100000);
+        }
+        line += '\n';
+        fwrite(line.data(), 1, line.size(), f);
+        written += line.size();
+    }
+    fclose(f);
+}
+
+void benchmarkFile(size_t bytes) {
+    const string path = "split_bench.tmp";
+    writeTestFile(path, bytes);
+    double gb = double(bytes) / (1024.0 * 1024.0 * 1024.0);
+
+    // Baseline: getline + the original split, summing every field
+    long long sumBaseline = 0, sumMmap = 0, sumChunked = 0;
+    double tBaseline = timeMs([&] {
+        ifstream in(path);
+        string s;
+        while (getline(in, s)) {
+            for (const string &f : splitOriginal(s, ',')) sumBaseline += f.size();
+        }
+    });
+
+    auto sumInto = [](long long &sum) {
+        return [&sum](const vector<string_view> &fields) {
+            for (string_view f : fields) sum += static_cast<long long>(f.size());
+        };
+    };
+    double tMmap = timeMs([&] { tokenizeFile(path, ',', sumInto(sumMmap), ReadMode::Mmap); });
+    double tChunked = timeMs([&] { tokenizeFile(path, ',', sumInto(sumChunked), ReadMode::Chunked); });
+    remove(path.c_str());
+
+    bool ok = sumBaseline == sumChunked && (sumMmap == 0 || sumMmap == sumBaseline);
+    cout << bytes / (1024 * 1024) << " MB file" << (ok ? "" : " (RESULTS DIFFER)") << "\n";
+    cout << "  getline + split  : " << tBaseline << " ms (" << gb / tBaseline * 1000 << " GB/s)\n";
+    if (sumMmap) cout << "  mmap tokenizer   : " << tMmap << " ms (" << gb / tMmap * 1000 << " GB/s)\n";
+    cout << "  chunked tokenizer: " << tChunked << " ms (" << gb / tChunked * 1000 << " GB/s)\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  ZERO-COPY STRING SPLIT\n";
+    cout << "========================================\n";
+    cout << "Delimiter scanner: " << scanner().name << "\n";
+
+    // ===== LAZY FORM =====
+    cout << "\n--- split(s, ' ') (lazy) ---\n";
+    string s = "Hello This Is Programming";
+    for (string_view tok : split(s, ' ')) {
+        cout << "[" << tok << "] ";
+    }
+    cout << "\n";
+
+    // ===== EAGER FORM =====
+    cout << "\n--- split(s, ',', out) (eager, empty fields kept) ---\n";
+    vector<string_view> fields;
+    split("id,,name,age", ',', fields);
+    for (string_view f : fields) cout << "[" << f << "] ";
+    cout << "\n";
+
+    // ===== MULTI-CHAR AND ANY-OF =====
+    cout << "\n--- multi-char and any-of delimiters ---\n";
+    for (string_view tok : split("std::vector::iterator", Str("::"))) cout << "[" << tok << "] ";
+    cout << "\n";
+    for (string_view tok : split("a b\tc  \td", AnyOf(" \t"), true)) cout << "[" << tok << "] ";
+    cout << "\n";
+
+    // ===== BENCHMARK =====
+    // Pass a size in MB to test bigger lines: ./split 1024
+    cout << "\n--- BENCHMARK ---\n";
+    size_t mb = argc > 1 ? strtoull(argv[1], nullptr, 10) : 64;
+    benchmark(mb * 1024 * 1024);
+
+    // ===== STREAMING A FILE =====
+    cout << "\n--- BENCHMARK: streaming file tokenizer ---\n";
+    benchmarkFile(mb * 1024 * 1024);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. STRING_VIEW:
+   - A pointer + length into someone else's characters
+   - Making one never allocates or copies
+   - The original string must stay alive while views are used
+
+2. LAZY VS EAGER:
+   - Lazy (range + iterator) finds one token at a time, can stop early
+   - Eager fills a caller-owned vector; reuse it across lines to avoid reallocating
+
+3. SIMD SCANNING:
+   - Compare 16 (SSE2) or 32 (AVX2) bytes with one instruction
+   - movemask turns the comparison into a bitmask; ctz finds the first hit
+   - A scalar loop handles the leftover tail
+
+4. RUNTIME DISPATCH:
+   - target("avx2") compiles one function for AVX2 without -mavx2
+   - __builtin_cpu_supports picks the fastest version on the running CPU
+   - Non-x86 builds use the scalar scanner
+
+5. DELIMITER KINDS:
+   - split(s, ',')          single character
+   - split(s, Str("::"))    multi-character string
+   - split(s, AnyOf(" \t")) any character from a set
+
+6. STREAMING FILES:
+   - mmap maps the file into memory: no read() copies, the OS pages it in
+   - Without mmap, read big chunks into one reusable buffer
+   - A record cut by a chunk boundary is moved to the front before the next read
+   - Reuse one fields vector for every record: zero allocations per line
+
+COMPILATION:
+    g++ -std=c++17 -O2 06_String_Split.cpp -o split && ./split
+    ./split 1024   (1 GB line and file benchmarks)
+
+NEXT STEP: Count things fast without map<char,int>!
+*/
@@ -0,0 +1,440 @@
+/*
+=============================================================
+     FAST FREQUENCY COUNTER - PERFORMANCE TUTORIAL
+     File: 07_Frequency_Counter.cpp
+=============================================================
+Learn: flat tables, histogram sub-tables, open addressing,
+       compile-time backend selection, per-thread merging
+
+main4.cpp counts characters like this:
+
+    map<int,int> mp;
+    for(char c: chr) mp[c]++;
+
+std::map is a red-black tree: every new key allocates a node and every
+mp[c]++ walks log(n) pointers scattered around the heap. For counting
+there are much faster layouts:
+  - byte keys (char): only 256 possible values -> a plain array
+  - bulk byte input : the same array, split into sub-tables
+  - any other key   : an open-addressing hash table in one flat array
+FrequencyCounter<Key> picks the right one at compile time.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+// ============= BACKEND 1: FLAT BYTE TABLE =============
+
+/*
+A char has 256 possible values, so counts[c] is the whole "map".
+No hashing, no allocation, one increment per character.
+*/
+template <typename Key>
+class ByteCounter {
+    private:
+        array<uint64_t, 256> counts{};
+
+        static unsigned char index(Key k) {
+            return static_cast<unsigned char>(k);
+        }
+
+    public:
+        void add(Key k, uint64_t times = 1) {
+            counts[index(k)] += times;
+        }
+
+        template <typename It>
+        void add(It first, It last) {
+            if constexpr (is_pointer_v<It> || is_same_v<It, typename vector<Key>::iterator> ||
+                          is_same_v<It, typename vector<Key>::const_iterator> ||
+                          is_same_v<It, string::iterator> || is_same_v<It, string::const_iterator>) {
+                if (first != last) addBulk(&*first, static_cast<size_t>(last - first));
+            } else {
+                for (; first != last; ++first) add(*first);
+            }
+        }
+
+        /*
+        Bulk histogram. With a single table, runs of the same byte
+        ("AAAA...") make each increment wait for the previous one to be
+        stored. Four sub-tables break that chain: consecutive bytes go to
+        different tables, so the CPU can overlap the increments. We load
+        8 bytes at a time as one 64-bit word and pick them apart with
+        shifts. 32-bit sub-counters are flushed every 1G bytes so they
+        can never overflow.
+        */
+        void addBulk(const Key *data, size_t n) {
+            const unsigned char *p = reinterpret_cast<const unsigned char*>(data);
+            const size_t blockBytes = size_t(1) << 30;
+            while (n > 0) {
+                size_t len = min(n, blockBytes);
+                uint32_t sub[4][256] = {};
+                size_t i = 0;
+                for (; i + 8 <= len; i += 8) {
+                    uint64_t w;
+                    memcpy(&w, p + i, 8);
+                    sub[0][w & 0xFF]++;
+                    sub[1][(w >> 8) & 0xFF]++;
+                    sub[2][(w >> 16) & 0xFF]++;
+                    sub[3][(w >> 24) & 0xFF]++;
+                    sub[0][(w >> 32) & 0xFF]++;
+                    sub[1][(w >> 40) & 0xFF]++;
+                    sub[2][(w >> 48) & 0xFF]++;
+                    sub[3][w >> 56]++;
+                }
+                for (; i < len; i++) sub[0][p[i]]++;
+                for (int b = 0; b < 256; b++) {
+                    counts[b] += uint64_t(sub[0][b]) + sub[1][b] + sub[2][b] + sub[3][b];
+                }
+                p += len;
+                n -= len;
+            }
+        }
+
+        uint64_t operator[](Key k) const {
+            return counts[index(k)];
+        }
+
+        void merge(const ByteCounter &other) {
+            for (int b = 0; b < 256; b++) counts[b] += other.counts[b];
+        }
+
+        size_t distinct() const {
+            return static_cast<size_t>(count_if(counts.begin(), counts.end(), [](uint64_t c) { return c > 0; }));
+        }
+
+        // Visits keys in ascending byte order, like iterating a map
+        template <typename Func>
+        void forEach(Func f) const {
+            for (int b = 0; b < 256; b++) {
+                if (counts[b]) f(static_cast<Key>(static_cast<unsigned char>(b)), counts[b]);
+            }
+        }
+};
+
+// ============= BACKEND 2: OPEN-ADDRESSING HASH TABLE =============
+
+/*
+All slots live in one vector. To find a key we hash it to a slot and walk
+forward (linear probing) until we see the key or an empty slot. Neighbouring
+slots share cache lines, so a probe is usually one memory access.
+
+A slot with count == 0 is empty: a counted key always has count >= 1.
+The table doubles before it is 70% full to keep probe chains short.
+*/
+template <typename Key, typename Hash = hash<Key>>
+class HashCounter {
+    private:
+        struct Slot {
+            Key key{};
+            uint64_t count = 0;
+        };
+
+        vector<Slot> slots;
+        size_t used = 0;
+        size_t mask = 0;
+        Hash hasher;
+
+        // std::hash<int> is often the identity, which clusters badly when we
+        // keep only the low bits. Multiplying by 2^64/phi spreads them out.
+        size_t slotFor(const Key &k) const {
+            uint64_t h = static_cast<uint64_t>(hasher(k)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(h >> 32) & mask;
+        }
+
+        void grow() {
+            vector<Slot> old = move(slots);
+            slots.assign(old.empty() ? 16 : old.size() * 2, Slot{});
+            mask = slots.size() - 1;
+            for (Slot &s : old) {
+                if (s.count == 0) continue;
+                size_t i = slotFor(s.key);
+                while (slots[i].count != 0) i = (i + 1) & mask;
+                slots[i] = move(s);
+            }
+        }
+
+    public:
+        HashCounter() {
+            grow();
+        }
+
+        void reserve(size_t keys) {
+            while (keys * 10 > slots.size() * 7) grow();
+        }
+
+        void add(const Key &k, uint64_t times = 1) {
+            if ((used + 1) * 10 > slots.size() * 7) grow();
+            size_t i = slotFor(k);
+            while (true) {
+                Slot &s = slots[i];
+                if (s.count == 0) {
+                    s.key = k;
+                    s.count = times;
+                    used++;
+                    return;
+                }
+                if (s.key == k) {
+                    s.count += times;
+                    return;
+                }
+                i = (i + 1) & mask;
+            }
+        }
+
+        template <typename It>
+        void add(It first, It last) {
+            for (; first != last; ++first) add(*first);
+        }
+
+        uint64_t operator[](const Key &k) const {
+            size_t i = slotFor(k);
+            while (slots[i].count != 0) {
+                if (slots[i].key == k) return slots[i].count;
+                i = (i + 1) & mask;
+            }
+            return 0;
+        }
+
+        void merge(const HashCounter &other) {
+            reserve(used + other.used);
+            other.forEach([this](const Key &k, uint64_t c) { add(k, c); });
+        }
+
+        size_t distinct() const {
+            return used;
+        }
+
+        // Visits keys in table order (unordered, like unordered_map)
+        template <typename Func>
+        void forEach(Func f) const {
+            for (const Slot &s : slots) {
+                if (s.count) f(s.key, s.count);
+            }
+        }
+};
+
+// ============= COMPILE-TIME BACKEND SELECTION =============
+
+/*
+FrequencyCounter<char>   -> ByteCounter  (256-entry array)
+FrequencyCounter<int>    -> HashCounter  (open addressing)
+FrequencyCounter<string> -> HashCounter
+*/
+template <typename Key>
+constexpr bool isByteKey = is_integral_v<Key> && sizeof(Key) == 1 && !is_same_v<Key, bool>;
+
+template <typename Key>
+using FrequencyCounter = conditional_t<isByteKey<Key>, ByteCounter<Key>, HashCounter<Key>>;
+
+// Convenience: count a whole container
+template <typename Container>
+auto countFrequencies(const Container &c) {
+    FrequencyCounter<typename Container::value_type> counter;
+    counter.add(c.begin(), c.end());
+    return counter;
+}
+
+// ============= PARALLEL COUNTING =============
+
+/*
+Threads must not increment the same counter at the same time. Instead each
+thread counts its own slice into a private counter, and the results are
+merged at the end. Merging costs O(distinct keys), not O(n).
+*/
+template <typename Key>
+FrequencyCounter<Key> countParallel(const Key *data, size_t n, size_t threads = thread::hardware_concurrency()) {
+    if (threads == 0) threads = 1;
+    threads = min(threads, max<size_t>(1, n / 65536));  // Tiny inputs aren't worth a thread
+    vector<FrequencyCounter<Key>> partial(threads);
+    vector<thread> workers;
+    size_t step = (n + threads - 1) / threads;
+    for (size_t t = 0; t < threads; t++) {
+        size_t b = min(n, t * step), e = min(n, b + step);
+        workers.emplace_back([&partial, data, t, b, e] {
+            partial[t].add(data + b, data + e);
+        });
+    }
+    for (thread &w : workers) w.join();
+    for (size_t t = 1; t < threads; t++) partial[0].merge(partial[t]);
+    return move(partial[0]);
+}
+
+template <typename Key>
+FrequencyCounter<Key> countParallel(const vector<Key> &v, size_t threads = thread::hardware_concurrency()) {
+    return countParallel(v.data(), v.size(), threads);
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void benchmarkBytes(size_t n) {
+    // Skewed text-like data: mostly letters, long runs now and then
+    string text(n, 'a');
+    unsigned seed = 7;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        text[i] = (seed >> 28) == 0 ? 'A' : static_cast<char>('a' + (seed >> 16) % 26);
+    }
+    uint64_t expected = 0, got = 0;
+
+    double tMap = timeMs([&] {
+        map<char, int> mp;
+        for (char c : text) mp[c]++;
+        expected = static_cast<uint64_t>(mp['e']);
+    });
+    double tUnordered = timeMs([&] {
+        unordered_map<char, int> mp;
+        for (char c : text) mp[c]++;
+        got = static_cast<uint64_t>(mp['e']);
+    });
+    bool ok = got == expected;
+    double tTable = timeMs([&] {
+        ByteCounter<char> fc;
+        for (char c : text) fc.add(c);
+        got = fc['e'];
+    });
+    ok = ok && got == expected;
+    double tBulk = timeMs([&] { got = countFrequencies(text)['e']; });
+    ok = ok && got == expected;
+    double tPar = timeMs([&] { got = countParallel(text.data(), text.size())['e']; });
+    ok = ok && got == expected;
+
+    cout << n << " chars" << (ok ? "" : " (COUNTS DIFFER)") << "\n";
+    cout << "  map<char,int>           : " << tMap << " ms\n";
+    cout << "  unordered_map<char,int> : " << tUnordered << " ms\n";
+    cout << "  flat table, one by one  : " << tTable << " ms\n";
+    cout << "  sub-table histogram     : " << tBulk << " ms\n";
+    cout << "  parallel histogram      : " << tPar << " ms\n";
+}
+
+void benchmarkInts(size_t n, int distinctKeys) {
+    vector<int> data(n);
+    unsigned seed = 11;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = static_cast<int>((seed >> 8) % static_cast<unsigned>(distinctKeys));
+    }
+    uint64_t expected = 0, got = 0;
+
+    double tMap = timeMs([&] {
+        map<int, int> mp;
+        for (int x : data) mp[x]++;
+        expected = static_cast<uint64_t>(mp[42]);
+    });
+    double tUnordered = timeMs([&] {
+        unordered_map<int, int> mp;
+        for (int x : data) mp[x]++;
+        got = static_cast<uint64_t>(mp[42]);
+    });
+    bool ok = got == expected;
+    double tHash = timeMs([&] { got = countFrequencies(data)[42]; });
+    ok = ok && got == expected;
+    double tPar = timeMs([&] { got = countParallel(data)[42]; });
+    ok = ok && got == expected;
+
+    cout << n << " ints, " << distinctKeys << " distinct" << (ok ? "" : " (COUNTS DIFFER)") << "\n";
+    cout << "  map<int,int>            : " << tMap << " ms\n";
+    cout << "  unordered_map<int,int>  : " << tUnordered << " ms\n";
+    cout << "  open-addressing counter : " << tHash << " ms\n";
+    cout << "  parallel + merge        : " << tPar << " ms\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main() {
+    cout << "========================================\n";
+    cout << "  FAST FREQUENCY COUNTER\n";
+    cout << "========================================\n";
+
+    // ===== SAME EXAMPLE AS main4.cpp =====
+    cout << "\n--- Counting chars (byte table) ---\n";
+    vector<char> chr = {'A', 'A', 'B', 'B', 'B', 'C'};
+    FrequencyCounter<char> mp = countFrequencies(chr);
+    mp.forEach([](char c, uint64_t n) {
+        cout << c << " => " << n << "\n";
+    });
+
+    // ===== GENERAL KEYS =====
+    cout << "\n--- Counting words (hash table) ---\n";
+    vector<string> words = {"red", "blue", "red", "green", "blue", "red"};
+    FrequencyCounter<string> wc = countFrequencies(words);
+    cout << "red => " << wc["red"] << ", blue => " << wc["blue"]
+         << ", purple => " << wc["purple"] << " (" << wc.distinct() << " distinct)\n";
+
+    // ===== PARALLEL =====
+    cout << "\n--- Parallel count ---\n";
+    vector<int> nums(1000000);
+    for (size_t i = 0; i < nums.size(); i++) nums[i] = static_cast<int>(i % 10);
+    auto pc = countParallel(nums, 4);
+    cout << "7 appears " << pc[7] << " times\n";
+
+    // ===== BENCHMARK =====
+    cout << "\n--- BENCHMARK: byte keys ---\n";
+    benchmarkBytes(100000000);
+    cout << "\n--- BENCHMARK: int keys ---\n";
+    benchmarkInts(10000000, 1000);
+    benchmarkInts(2000000, 1000000);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. WHY map<char,int> IS SLOW FOR COUNTING:
+   - Each new key allocates a tree node
+   - Each mp[c]++ follows log(n) pointers to random memory
+   - unordered_map still allocates one node per key
+
+2. FLAT BYTE TABLE:
+   - 256 possible chars -> array<uint64_t, 256>
+   - counts[c]++ is a single memory increment
+
+3. HISTOGRAM SUB-TABLES:
+   - Repeated bytes make increments wait on each other
+   - Spreading bytes over 4 tables lets the CPU run them in parallel
+   - Read 8 bytes at once, extract each with a shift
+
+4. OPEN ADDRESSING:
+   - Keys and counts live directly in one array (no nodes)
+   - Collisions: try the next slot (linear probing)
+   - Grow before ~70% full to keep probes short
+
+5. COMPILE-TIME SELECTION:
+   - conditional_t<isByteKey<Key>, ByteCounter, HashCounter>
+   - The choice costs nothing at runtime
+
+6. PARALLEL COUNTING:
+   - One private counter per thread (no locks, no sharing)
+   - Merge at the end: cost depends on distinct keys, not input size
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 07_Frequency_Counter.cpp -o freq && ./freq
+
+NEXT STEP: A full flat hash map to replace unordered_map<int,int>!
+*/
@@ -0,0 +1,621 @@
+/*
+=============================================================
+     FLAT HASH MAP - PERFORMANCE TUTORIAL
+     File: 08_Flat_Hash_Map.cpp
+=============================================================
+Learn: open addressing, control bytes, SIMD group probing,
+       backward-shift deletion, heterogeneous lookup
+
+main4.cpp stores key/value pairs like this:
+
+    unordered_map<int,int> mp;
+    for(...) { cin >> key >> val; mp[key] = val; }
+    for(auto& i: mp) cout << i.first << i.second;
+
+std::unordered_map is "node based": every element is a separate heap
+allocation hanging off a bucket list, so every insert calls malloc and
+every lookup chases a pointer to a random address (a cache miss).
+
+FlatHashMap keeps everything in two flat arrays:
+  ctrl[]  : 1 byte per slot (EMPTY, or 7 bits of the key's hash)
+  slots[] : the key/value pairs themselves
+A lookup compares 16 control bytes at once with one SSE2 instruction and
+only touches the slots whose hash bits match.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include <iterator>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// ============= CONTROL BYTES & GROUP MATCHING =============
+
+/*
+Every slot has one control byte:
+    EMPTY (0x80)       the slot is free
+    0x00 .. 0x7F       the slot is full; value = low 7 bits of the hash ("H2")
+The other hash bits ("H1") choose the home slot.
+
+Group: 16 consecutive control bytes. match(h2) returns a 16-bit mask with
+bit i set if byte i == h2, so 16 candidates are filtered in one step.
+*/
+constexpr int8_t CTRL_EMPTY = static_cast<int8_t>(0x80);
+constexpr size_t GROUP_WIDTH = 16;
+
+struct Group {
+#ifdef __SSE2__
+    __m128i bytes;
+
+    explicit Group(const int8_t *p) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    uint32_t match(int8_t h) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h))));
+    }
+#else
+    // Portable fallback: same result, one byte at a time
+    int8_t bytes[GROUP_WIDTH];
+
+    explicit Group(const int8_t *p) {
+        memcpy(bytes, p, GROUP_WIDTH);
+    }
+
+    uint32_t match(int8_t h) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) mask |= uint32_t(bytes[i] == h) << i;
+        return mask;
+    }
+#endif
+
+    uint32_t matchEmpty() const {
+        return match(CTRL_EMPTY);
+    }
+};
+
+inline unsigned lowestBit(uint32_t mask) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// ============= TRANSPARENT STRING HASH =============
+
+/*
+Heterogeneous lookup: with a "transparent" hash and equality, a
+FlatHashMap<string, V> can be searched with a string_view or const char*
+without first building a temporary std::string.
+*/
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(string_view s) const {
+        return hash<string_view>{}(s);
+    }
+};
+
+// ============= FLAT HASH MAP =============
+
+/*
+Collision strategy: linear probing from the home slot, scanned one
+16-byte group at a time. A key is always found before the first EMPTY
+slot after its home, so a lookup can stop as soon as a group has an
+EMPTY byte.
+
+Deletion without tombstones: after erasing slot i, later entries of the
+same probe run are shifted back into the hole ("backward shift"). The
+table never fills up with "deleted" markers, so lookups stay fast after
+heavy insert/erase churn and no periodic cleanup rehash is needed.
+
+The control array has GROUP_WIDTH - 1 extra bytes at the end that mirror
+the first bytes, so a group that starts near the end can be loaded in
+one piece instead of wrapping around.
+*/
+template <typename K, typename V, typename Hash = hash<K>, typename Eq = equal_to<>>
+class FlatHashMap {
+    public:
+        using value_type = pair<K, V>;  // Do not modify .first through an iterator
+
+    private:
+        int8_t *ctrl = nullptr;
+        value_type *slots = nullptr;
+        size_t capacity = 0;  // Power of two, >= GROUP_WIDTH
+        size_t used = 0;
+        Hash hasher;
+        Eq equal;
+
+        static constexpr size_t maxLoadPercent = 80;
+
+        // Mix the user hash so both H1 and H2 get well-spread bits
+        // (std::hash<int> is usually the identity function)
+        size_t mixedHash(size_t h) const {
+            uint64_t x = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(x ^ (x >> 32));
+        }
+        size_t homeSlot(size_t h) const {
+            return (h >> 7) & (capacity - 1);
+        }
+        static int8_t h2(size_t h) {
+            return static_cast<int8_t>(h & 0x7F);
+        }
+
+        void setCtrl(size_t i, int8_t v) {
+            ctrl[i] = v;
+            if (i < GROUP_WIDTH - 1) ctrl[capacity + i] = v;  // Keep the mirror in sync
+        }
+
+        // Returns the slot holding key, or capacity if it is not present
+        template <typename Q>
+        size_t findSlot(const Q &key, size_t h) const {
+            if (capacity == 0) return 0;
+            size_t pos = homeSlot(h);
+            int8_t tag = h2(h);
+            while (true) {
+                Group g(ctrl + pos);
+                for (uint32_t m = g.match(tag); m; m &= m - 1) {
+                    size_t i = (pos + lowestBit(m)) & (capacity - 1);
+                    if (equal(slots[i].first, key)) return i;
+                }
+                if (g.matchEmpty()) return capacity;
+                pos = (pos + GROUP_WIDTH) & (capacity - 1);
+            }
+        }
+
+        // First EMPTY slot at or after the home slot
+        size_t findEmpty(size_t h) const {
+            size_t pos = homeSlot(h);
+            while (true) {
+                uint32_t m = Group(ctrl + pos).matchEmpty();
+                if (m) return (pos + lowestBit(m)) & (capacity - 1);
+                pos = (pos + GROUP_WIDTH) & (capacity - 1);
+            }
+        }
+
+        void allocate(size_t cap) {
+            capacity = cap;
+            ctrl = static_cast<int8_t*>(::operator new(cap + GROUP_WIDTH - 1));
+            memset(ctrl, static_cast<unsigned char>(CTRL_EMPTY), cap + GROUP_WIDTH - 1);
+            slots = static_cast<value_type*>(::operator new(cap * sizeof(value_type), align_val_t(alignof(value_type))));
+        }
+
+        void release() {
+            if (!ctrl) return;
+            for (size_t i = 0; i < capacity; i++) {
+                if (ctrl[i] != CTRL_EMPTY) slots[i].~value_type();
+            }
+            ::operator delete(ctrl);
+            ::operator delete(slots, align_val_t(alignof(value_type)));
+            ctrl = nullptr;
+            slots = nullptr;
+            capacity = used = 0;
+        }
+
+        void rehash(size_t newCap) {
+            int8_t *oldCtrl = ctrl;
+            value_type *oldSlots = slots;
+            size_t oldCap = capacity;
+            allocate(newCap);
+            for (size_t i = 0; i < oldCap; i++) {
+                if (oldCtrl[i] == CTRL_EMPTY) continue;
+                size_t h = mixedHash(hasher(oldSlots[i].first));
+                size_t j = findEmpty(h);
+                setCtrl(j, h2(h));
+                new (&slots[j]) value_type(move(oldSlots[i]));
+                oldSlots[i].~value_type();
+            }
+            ::operator delete(oldCtrl);
+            ::operator delete(oldSlots, align_val_t(alignof(value_type)));
+        }
+
+        void growIfNeeded() {
+            if (capacity == 0) rehash(GROUP_WIDTH);
+            else if ((used + 1) * 100 > capacity * maxLoadPercent) rehash(capacity * 2);
+        }
+
+        // Insert key (if missing) and return its slot; second = true if inserted
+        template <typename Q, typename... Args>
+        pair<size_t, bool> tryEmplaceSlot(Q &&key, Args &&...args) {
+            size_t h = mixedHash(hasher(key));
+            size_t i = findSlot(key, h);
+            if (capacity != 0 && i != capacity) return {i, false};
+            growIfNeeded();
+            i = findEmpty(h);
+            new (&slots[i]) value_type(piecewise_construct,
+                                       forward_as_tuple(forward<Q>(key)),
+                                       forward_as_tuple(forward<Args>(args)...));
+            setCtrl(i, h2(h));
+            used++;
+            return {i, true};
+        }
+
+        // Does home slot h lie cyclically in (hole, j]? Then the entry at j
+        // cannot move back into hole without jumping over its home.
+        bool homeBetween(size_t hole, size_t home, size_t j) const {
+            return hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+        }
+
+        void eraseSlot(size_t hole) {
+            slots[hole].~value_type();
+            setCtrl(hole, CTRL_EMPTY);
+            used--;
+            // Backward shift: pull later members of the probe run into the hole
+            size_t j = hole;
+            while (true) {
+                j = (j + 1) & (capacity - 1);
+                if (ctrl[j] == CTRL_EMPTY) return;
+                size_t home = homeSlot(mixedHash(hasher(slots[j].first)));
+                if (homeBetween(hole, home, j)) continue;
+                new (&slots[hole]) value_type(move(slots[j]));
+                setCtrl(hole, ctrl[j]);
+                slots[j].~value_type();
+                setCtrl(j, CTRL_EMPTY);
+                hole = j;
+            }
+        }
+
+        template <typename H, typename E>
+        using IfTransparent = void_t<typename H::is_transparent, typename E::is_transparent>;
+
+    public:
+        // ----- Iteration -----
+
+        template <bool Const>
+        class Iter {
+            private:
+                using Map = conditional_t<Const, const FlatHashMap, FlatHashMap>;
+                Map *map = nullptr;
+                size_t i = 0;
+
+                void skipEmpty() {
+                    while (i < map->capacity && map->ctrl[i] == CTRL_EMPTY) i++;
+                }
+
+                friend class FlatHashMap;
+
+            public:
+                using iterator_category = forward_iterator_tag;
+                using value_type = FlatHashMap::value_type;
+                using difference_type = ptrdiff_t;
+                using reference = conditional_t<Const, const value_type&, value_type&>;
+                using pointer = conditional_t<Const, const value_type*, value_type*>;
+
+                Iter() = default;
+                Iter(Map *m, size_t pos, bool skip) : map(m), i(pos) {
+                    if (skip) skipEmpty();
+                }
+                operator Iter<true>() const {
+                    return Iter<true>(map, i, false);
+                }
+
+                reference operator*() const {
+                    return map->slots[i];
+                }
+                pointer operator->() const {
+                    return &map->slots[i];
+                }
+                Iter& operator++() {
+                    i++;
+                    skipEmpty();
+                    return *this;
+                }
+                Iter operator++(int) {
+                    Iter old = *this;
+                    ++*this;
+                    return old;
+                }
+                bool operator==(const Iter &o) const {
+                    return i == o.i;
+                }
+                bool operator!=(const Iter &o) const {
+                    return i != o.i;
+                }
+        };
+
+        using iterator = Iter<false>;
+        using const_iterator = Iter<true>;
+
+        iterator begin() {
+            return iterator(this, 0, true);
+        }
+        iterator end() {
+            return iterator(this, capacity, false);
+        }
+        const_iterator begin() const {
+            return const_iterator(this, 0, true);
+        }
+        const_iterator end() const {
+            return const_iterator(this, capacity, false);
+        }
+
+        // ----- Construction -----
+
+        FlatHashMap() = default;
+
+        FlatHashMap(initializer_list<value_type> init) {
+            reserve(init.size());
+            for (const value_type &kv : init) insert(kv);
+        }
+
+        FlatHashMap(const FlatHashMap &other) : hasher(other.hasher), equal(other.equal) {
+            reserve(other.used);
+            for (const value_type &kv : other) insert(kv);
+        }
+
+        FlatHashMap(FlatHashMap &&other) noexcept
+            : ctrl(other.ctrl), slots(other.slots), capacity(other.capacity), used(other.used),
+              hasher(move(other.hasher)), equal(move(other.equal)) {
+            other.ctrl = nullptr;
+            other.slots = nullptr;
+            other.capacity = other.used = 0;
+        }
+
+        FlatHashMap& operator=(FlatHashMap other) noexcept {
+            swap(ctrl, other.ctrl);
+            swap(slots, other.slots);
+            swap(capacity, other.capacity);
+            swap(used, other.used);
+            swap(hasher, other.hasher);
+            swap(equal, other.equal);
+            return *this;
+        }
+
+        ~FlatHashMap() {
+            release();
+        }
+
+        // ----- Capacity -----
+
+        size_t size() const {
+            return used;
+        }
+        bool empty() const {
+            return used == 0;
+        }
+
+        // Make room for n elements so the next n inserts never rehash
+        void reserve(size_t n) {
+            size_t need = GROUP_WIDTH;
+            while (n * 100 > need * maxLoadPercent) need *= 2;
+            if (need > capacity) rehash(need);
+        }
+
+        void clear() {
+            for (size_t i = 0; i < capacity; i++) {
+                if (ctrl[i] != CTRL_EMPTY) {
+                    slots[i].~value_type();
+                    ctrl[i] = CTRL_EMPTY;
+                }
+            }
+            if (ctrl) memset(ctrl + capacity, static_cast<unsigned char>(CTRL_EMPTY), GROUP_WIDTH - 1);
+            used = 0;
+        }
+
+        // ----- Lookup -----
+
+        iterator find(const K &key) {
+            size_t i = findSlot(key, mixedHash(hasher(key)));
+            return iterator(this, capacity == 0 ? 0 : i, false);
+        }
+        const_iterator find(const K &key) const {
+            size_t i = findSlot(key, mixedHash(hasher(key)));
+            return const_iterator(this, capacity == 0 ? 0 : i, false);
+        }
+
+        // Heterogeneous lookup: only enabled when Hash and Eq are transparent
+        template <typename Q, typename H = Hash, typename E = Eq, typename = IfTransparent<H, E>>
+        iterator find(const Q &key) {
+            size_t i = findSlot(key, mixedHash(hasher(key)));
+            return iterator(this, capacity == 0 ? 0 : i, false);
+        }
+        template <typename Q, typename H = Hash, typename E = Eq, typename = IfTransparent<H, E>>
+        const_iterator find(const Q &key) const {
+            size_t i = findSlot(key, mixedHash(hasher(key)));
+            return const_iterator(this, capacity == 0 ? 0 : i, false);
+        }
+
+        template <typename Q>
+        bool contains(const Q &key) const {
+            return find(key) != end();
+        }
+        template <typename Q>
+        size_t count(const Q &key) const {
+            return contains(key) ? 1 : 0;
+        }
+
+        // ----- Insert -----
+
+        // (The slot index must be computed before reading slots: inserting may rehash)
+        V& operator[](const K &key) {
+            size_t i = tryEmplaceSlot(key).first;
+            return slots[i].second;
+        }
+        V& operator[](K &&key) {
+            size_t i = tryEmplaceSlot(move(key)).first;
+            return slots[i].second;
+        }
+
+        template <typename... Args>
+        pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+            auto [i, inserted] = tryEmplaceSlot(key, forward<Args>(args)...);
+            return {iterator(this, i, false), inserted};
+        }
+
+        pair<iterator, bool> insert(const value_type &kv) {
+            return try_emplace(kv.first, kv.second);
+        }
+
+        // ----- Erase -----
+
+        template <typename Q>
+        size_t erase(const Q &key) {
+            if (capacity == 0) return 0;
+            size_t i = findSlot(key, mixedHash(hasher(key)));
+            if (i == capacity) return 0;
+            eraseSlot(i);
+            return 1;
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Random-looking but reproducible keys
+vector<int> makeKeys(size_t n, unsigned seed) {
+    vector<int> keys(n);
+    uint64_t x = seed;
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        keys[i] = static_cast<int>(x & 0x7FFFFFFF);
+    }
+    return keys;
+}
+
+template <typename Map>
+void runMapBenchmark(const char *name, const vector<int> &keys, const vector<int> &misses) {
+    Map mp;
+    long long sum = 0;
+    double tInsert = timeMs([&] {
+        for (size_t i = 0; i < keys.size(); i++) mp[keys[i]] = static_cast<int>(i);
+    });
+    double tHit = timeMs([&] {
+        for (int k : keys) {
+            auto it = mp.find(k);
+            if (it != mp.end()) sum += it->second;
+        }
+    });
+    double tMiss = timeMs([&] {
+        for (int k : misses) sum += mp.find(k) != mp.end();
+    });
+    double tIterate = timeMs([&] {
+        for (auto &kv : mp) sum += kv.second;
+    });
+    double tErase = timeMs([&] {
+        for (size_t i = 0; i < keys.size(); i += 2) mp.erase(keys[i]);
+    });
+    double perOp = 1e6 / static_cast<double>(keys.size());  // ms -> ns per element
+    cout << "  " << name << " insert " << tInsert * perOp << " ns, hit " << tHit * perOp
+         << " ns, miss " << tMiss * perOp << " ns, iterate " << tIterate * perOp
+         << " ns, erase " << tErase * perOp * 2 << " ns  (left " << mp.size() << ", sum " << sum << ")\n";
+}
+
+void benchmark(size_t n) {
+    vector<int> keys = makeKeys(n, 12345);
+    vector<int> misses = makeKeys(n, 999);
+    for (int &k : misses) k = -k - 1;  // Negative: never inserted
+    cout << n << " entries (per element):\n";
+    runMapBenchmark<unordered_map<int, int>>("unordered_map", keys, misses);
+    runMapBenchmark<FlatHashMap<int, int>>("FlatHashMap  ", keys, misses);
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  FLAT HASH MAP\n";
+    cout << "========================================\n";
+
+    // ===== SAME USAGE AS main4.cpp =====
+    cout << "\n--- operator[] and iteration ---\n";
+    FlatHashMap<int, int> mp;
+    mp[3] = 5;
+    mp[2] = 10;
+    mp[1] = 8;
+    for (auto &i : mp) {
+        cout << "key :" << i.first << " values:" << i.second << "\n";
+    }
+
+    // ===== FIND / ERASE =====
+    cout << "\n--- find / erase ---\n";
+    cout << "contains 2? " << mp.contains(2) << "\n";
+    mp.erase(2);
+    cout << "after erase(2): contains 2? " << mp.contains(2) << ", size " << mp.size() << "\n";
+
+    // ===== HETEROGENEOUS LOOKUP =====
+    cout << "\n--- string keys, string_view lookup ---\n";
+    FlatHashMap<string, int, StringHash, equal_to<>> colors = {{"Purple", 1}, {"Black", 2}};
+    string_view query = "Black";
+    auto it = colors.find(query);  // No temporary std::string is built
+    if (it != colors.end()) cout << it->first << " => " << it->second << "\n";
+
+    // ===== RESERVE =====
+    FlatHashMap<int, int> big;
+    big.reserve(1000000);  // No rehash during the next 1M inserts
+    for (int i = 0; i < 1000000; i++) big[i] = i;
+    for (int i = 0; i < 1000000; i += 2) big.erase(i);
+    cout << "\nreserved map after churn: " << big.size() << " entries, big[999] = " << big[999] << "\n";
+
+    // ===== BENCHMARK =====
+    // Largest size can be raised on the command line: ./flatmap 100000000
+    cout << "\n--- BENCHMARK vs unordered_map<int,int> ---\n";
+    size_t maxN = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        benchmark(n);
+    }
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. NODE-BASED VS FLAT:
+   - unordered_map: one heap node per element, lookups follow pointers
+   - FlatHashMap: all elements in one array, no per-element allocation
+
+2. CONTROL BYTES:
+   - 1 byte per slot: EMPTY or 7 bits of the hash
+   - Most non-matching slots are rejected without touching the key
+
+3. SIMD GROUP PROBING:
+   - Load 16 control bytes, compare with one instruction (SSE2)
+   - movemask gives a bitmask of candidates; check only those keys
+
+4. DELETION WITHOUT TOMBSTONES:
+   - Backward shift moves later entries of the probe run into the hole
+   - No "deleted" markers build up, so lookups don't slow down over time
+
+5. HETEROGENEOUS LOOKUP:
+   - Hash and equality marked "is_transparent"
+   - find(string_view) on a map with string keys, no temporary string
+
+6. RESERVE:
+   - reserve(n) sizes the table once so n inserts never rehash
+
+COMPILATION:
+    g++ -std=c++17 -O2 08_Flat_Hash_Map.cpp -o flatmap && ./flatmap
+
+NEXT STEP: Sorted flat containers for set<int> and map!
+*/
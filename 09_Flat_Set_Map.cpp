@@ -0,0 +1,503 @@
+/*
+=============================================================
+     SORTED FLAT SET / FLAT MAP - PERFORMANCE TUTORIAL
+     File: 09_Flat_Set_Map.cpp
+=============================================================
+Learn: sorted vectors, bulk construction, merge-based batch insert,
+       branchless binary search, Eytzinger (BFS) layout
+
+main4.cpp uses node-based ordered containers:
+
+    set<int> st = {1,2,3,3};
+    st.insert(4);
+    cout << (st.find(8) != st.end());
+
+    map<int,int> mp;  ...  for(pair<char,int> i: mp) ...
+
+std::set/std::map are red-black trees: one heap node per element, and
+every lookup follows ~log2(n) pointers to random addresses. For data that
+is read far more often than it is changed, a plain sorted vector is much
+faster: it is contiguous, half the memory, and binary search on it can be
+made branch-free.
+*/
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+using namespace std;
+
+// ============= BRANCHLESS LOWER BOUND =============
+
+/*
+std::lower_bound does "if (a[mid] < key) go right else go left". On random
+keys the CPU guesses that branch wrong half the time, and each wrong guess
+throws away ~15 cycles of work.
+
+The branchless version always halves the range and moves the base pointer
+with a conditional add, which compiles to a cmov instead of a jump.
+Returns the index of the first element not less than key.
+*/
+template <typename T, typename Key, typename KeyOf, typename Compare>
+size_t branchlessLowerBound(const T *base, size_t n, const Key &key, KeyOf keyOf, Compare comp) {
+    if (n == 0) return 0;
+    const T *first = base;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = comp(keyOf(base[half - 1]), key) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<size_t>(base - first) + (comp(keyOf(*base), key) ? 1 : 0);
+}
+
+// ============= EYTZINGER INDEX =============
+
+/*
+Binary search on a sorted array touches positions n/2, n/4 or 3n/4, ...
+which are far apart: every step is a cache miss for large n.
+
+The Eytzinger layout stores the same keys in breadth-first tree order:
+index 1 is the root, the children of k are 2k and 2k+1. The first few
+levels now share cache lines, and the next levels can be prefetched
+because the addresses 16k .. 16k+15 are known in advance.
+
+This index is a read-only copy of the keys. It is built with buildIndex()
+and dropped automatically by any modification of the container.
+*/
+template <typename Key, typename Compare>
+class EytzingerIndex {
+    private:
+        vector<Key> tree;        // tree[0] is unused
+        vector<uint32_t> rank;   // rank[k] = position of tree[k] in the sorted array
+        Compare comp;
+
+        template <typename It>
+        void fill(It &sorted, uint32_t &next, size_t k) {
+            if (k >= tree.size()) return;
+            fill(sorted, next, 2 * k);
+            tree[k] = *sorted;
+            ++sorted;
+            rank[k] = next++;
+            fill(sorted, next, 2 * k + 1);
+        }
+
+    public:
+        EytzingerIndex() = default;
+
+        template <typename It>
+        EytzingerIndex(It sortedKeys, size_t n, Compare c) : tree(n + 1), rank(n + 1), comp(c) {
+            uint32_t next = 0;
+            fill(sortedKeys, next, 1);  // In-order walk of the implicit tree
+        }
+
+        bool empty() const {
+            return tree.size() <= 1;
+        }
+
+        // Same result as lower_bound on the sorted array: a position in [0, n]
+        size_t lowerBound(const Key &key, size_t n) const {
+            size_t k = 1;
+            while (k <= n) {
+#if defined(__GNUC__)
+                __builtin_prefetch(tree.data() + k * 16);  // 4 levels ahead
+#endif
+                k = 2 * k + (comp(tree[k], key) ? 1 : 0);
+            }
+            // Undo the final run of "went right" steps (and one left step)
+#if defined(__GNUC__)
+            k >>= __builtin_ffsll(static_cast<long long>(~k));
+#else
+            while (k & 1) k >>= 1;
+            k >>= 1;
+#endif
+            return k == 0 ? n : rank[k];
+        }
+};
+
+// ============= SORTED VECTOR BASE =============
+
+/*
+FlatSet and FlatMap share everything except how to get the key out of an
+element (KeyOf), so the common code lives here.
+
+Invariant: data is sorted by key and holds no duplicate keys.
+*/
+template <typename Value, typename Key, typename KeyOf, typename Compare>
+class SortedVector {
+    protected:
+        vector<Value> data;
+        Compare comp;
+        KeyOf keyOf;
+        EytzingerIndex<Key, Compare> index;
+
+        bool equalKeys(const Key &a, const Key &b) const {
+            return !comp(a, b) && !comp(b, a);
+        }
+
+        // Any modification makes the Eytzinger copy stale
+        void invalidate() {
+            if (!index.empty()) index = EytzingerIndex<Key, Compare>();
+        }
+
+        // Sort + unique; for equal keys the first one wins
+        void normalize() {
+            stable_sort(data.begin(), data.end(), [this](const Value &a, const Value &b) {
+                return comp(keyOf(a), keyOf(b));
+            });
+            data.erase(unique(data.begin(), data.end(), [this](const Value &a, const Value &b) {
+                return equalKeys(keyOf(a), keyOf(b));
+            }), data.end());
+        }
+
+    public:
+        using iterator = typename vector<Value>::const_iterator;
+        using const_iterator = iterator;
+        using value_type = Value;
+
+        SortedVector() = default;
+
+        // Bulk construction: O(n log n) once, instead of n tree inserts
+        explicit SortedVector(vector<Value> values, Compare c = Compare()) : data(move(values)), comp(c) {
+            normalize();
+        }
+
+        iterator begin() const {
+            return data.begin();
+        }
+        iterator end() const {
+            return data.end();
+        }
+        size_t size() const {
+            return data.size();
+        }
+        bool empty() const {
+            return data.empty();
+        }
+        void reserve(size_t n) {
+            data.reserve(n);
+        }
+        void clear() {
+            data.clear();
+            invalidate();
+        }
+
+        // ----- Lookup -----
+
+        iterator lower_bound(const Key &key) const {
+            size_t i = index.empty() ? branchlessLowerBound(data.data(), data.size(), key, keyOf, comp)
+                                     : index.lowerBound(key, data.size());
+            return data.begin() + static_cast<ptrdiff_t>(i);
+        }
+
+        iterator upper_bound(const Key &key) const {
+            iterator it = lower_bound(key);
+            return (it != end() && equalKeys(keyOf(*it), key)) ? it + 1 : it;
+        }
+
+        iterator find(const Key &key) const {
+            iterator it = lower_bound(key);
+            return (it != end() && equalKeys(keyOf(*it), key)) ? it : end();
+        }
+
+        bool contains(const Key &key) const {
+            return find(key) != end();
+        }
+
+        size_t count(const Key &key) const {
+            return contains(key) ? 1 : 0;
+        }
+
+        // Build the cache-friendly lookup index (call after the data settles)
+        void buildIndex() {
+            vector<Key> keys;
+            keys.reserve(data.size());
+            for (const Value &v : data) keys.push_back(keyOf(v));
+            index = EytzingerIndex<Key, Compare>(keys.begin(), keys.size(), comp);
+        }
+
+        // ----- Modification -----
+
+        // Single insert is O(n) (elements after the slot shift right).
+        // Fine occasionally; use insertBatch for many at once.
+        pair<iterator, bool> insert(Value v) {
+            size_t i = branchlessLowerBound(data.data(), data.size(), keyOf(v), keyOf, comp);
+            if (i < data.size() && equalKeys(keyOf(data[i]), keyOf(v))) {
+                return {data.begin() + static_cast<ptrdiff_t>(i), false};
+            }
+            invalidate();
+            data.insert(data.begin() + static_cast<ptrdiff_t>(i), move(v));
+            return {data.begin() + static_cast<ptrdiff_t>(i), true};
+        }
+
+        /*
+        Batched insert: sort only the new elements, then merge the two sorted
+        runs in one linear pass. k new elements cost O(k log k + n) instead of
+        k separate O(n) shifts. Existing keys win over new duplicates,
+        like std::set::insert.
+        */
+        template <typename It>
+        void insertBatch(It first, It last) {
+            vector<Value> extra(first, last);
+            if (extra.empty()) return;
+            invalidate();
+            SortedVector fresh(move(extra), comp);
+            vector<Value> merged;
+            merged.reserve(data.size() + fresh.data.size());
+            auto less = [this](const Value &a, const Value &b) { return comp(keyOf(a), keyOf(b)); };
+            merge(make_move_iterator(data.begin()), make_move_iterator(data.end()),
+                  make_move_iterator(fresh.data.begin()), make_move_iterator(fresh.data.end()),
+                  back_inserter(merged), less);
+            // merge is stable, so for equal keys the old element comes first
+            merged.erase(unique(merged.begin(), merged.end(), [this](const Value &a, const Value &b) {
+                return equalKeys(keyOf(a), keyOf(b));
+            }), merged.end());
+            data = move(merged);
+        }
+
+        size_t erase(const Key &key) {
+            iterator it = find(key);
+            if (it == end()) return 0;
+            invalidate();
+            data.erase(it);
+            return 1;
+        }
+};
+
+// ============= FLAT SET =============
+
+struct Identity {
+    template <typename T>
+    const T& operator()(const T &v) const {
+        return v;
+    }
+};
+
+template <typename T, typename Compare = less<T>>
+class FlatSet : public SortedVector<T, T, Identity, Compare> {
+    private:
+        using Base = SortedVector<T, T, Identity, Compare>;
+
+    public:
+        using Base::Base;
+
+        FlatSet(initializer_list<T> init) : Base(vector<T>(init)) {}
+};
+
+// ============= FLAT MAP =============
+
+struct FirstOf {
+    template <typename P>
+    const typename P::first_type& operator()(const P &p) const {
+        return p.first;
+    }
+};
+
+/*
+Elements are pair<K, V> kept sorted by K. Iteration is in key order, the
+same as std::map. Values can be changed through at()/operator[]; keys
+never change once inserted.
+*/
+template <typename K, typename V, typename Compare = less<K>>
+class FlatMap : public SortedVector<pair<K, V>, K, FirstOf, Compare> {
+    private:
+        using Base = SortedVector<pair<K, V>, K, FirstOf, Compare>;
+
+        pair<K, V>& slotAt(typename Base::iterator it) {
+            return this->data[static_cast<size_t>(it - this->data.begin())];
+        }
+
+    public:
+        using Base::Base;
+
+        FlatMap(initializer_list<pair<K, V>> init) : Base(vector<pair<K, V>>(init)) {}
+
+        V& operator[](const K &key) {
+            auto it = this->lower_bound(key);
+            if (it == this->end() || !this->equalKeys(it->first, key)) {
+                it = this->insert({key, V()}).first;
+            }
+            return slotAt(it).second;
+        }
+
+        V& at(const K &key) {
+            auto it = this->find(key);
+            if (it == this->end()) throw out_of_range("FlatMap::at: key not found");
+            return slotAt(it).second;
+        }
+
+        const V& at(const K &key) const {
+            auto it = this->find(key);
+            if (it == this->end()) throw out_of_range("FlatMap::at: key not found");
+            return it->second;
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+vector<int> randomInts(size_t n, uint64_t seed) {
+    vector<int> v(n);
+    for (size_t i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        v[i] = static_cast<int>(seed & 0x3FFFFFFF);
+    }
+    return v;
+}
+
+void benchmark(size_t n) {
+    vector<int> keys = randomInts(n, 42);
+    vector<int> queries = randomInts(1000000, 7);
+    for (size_t i = 0; i < queries.size(); i += 2) queries[i] = keys[queries[i] % static_cast<int>(n)];  // Half hits
+    size_t hits[4] = {};
+
+    set<int> st;
+    double tBuildSet = timeMs([&] { st = set<int>(keys.begin(), keys.end()); });
+    FlatSet<int> fs;
+    double tBuildFlat = timeMs([&] { fs = FlatSet<int>(keys); });
+
+    double tSet = timeMs([&] {
+        for (int q : queries) hits[0] += st.find(q) != st.end();
+    });
+    double tStd = timeMs([&] {
+        for (int q : queries) hits[1] += binary_search(fs.begin(), fs.end(), q);
+    });
+    double tBranchless = timeMs([&] {
+        for (int q : queries) hits[2] += fs.contains(q);
+    });
+    fs.buildIndex();
+    double tEytzinger = timeMs([&] {
+        for (int q : queries) hits[3] += fs.contains(q);
+    });
+
+    bool ok = hits[0] == hits[1] && hits[1] == hits[2] && hits[2] == hits[3];
+    double perQuery = 1e6 / static_cast<double>(queries.size());
+    cout << n << " keys" << (ok ? "" : " (RESULTS DIFFER)") << "\n";
+    cout << "  build : set " << tBuildSet << " ms, FlatSet (sort+unique) " << tBuildFlat << " ms\n";
+    cout << "  lookup: set " << tSet * perQuery << " ns, std::binary_search " << tStd * perQuery
+         << " ns, branchless " << tBranchless * perQuery << " ns, Eytzinger " << tEytzinger * perQuery << " ns\n";
+
+    // Ordered iteration, map vs FlatMap
+    map<int, int> mp;
+    vector<pair<int, int>> pairs;
+    pairs.reserve(n);
+    for (size_t i = 0; i < n; i++) pairs.push_back({keys[i], static_cast<int>(i)});
+    mp.insert(pairs.begin(), pairs.end());
+    FlatMap<int, int> fm(pairs);
+    long long sumMap = 0, sumFlat = 0;
+    double tIterMap = timeMs([&] {
+        for (auto &kv : mp) sumMap += kv.second;
+    });
+    double tIterFlat = timeMs([&] {
+        for (auto &kv : fm) sumFlat += kv.second;
+    });
+    cout << "  iterate: map " << tIterMap << " ms, FlatMap " << tIterFlat << " ms"
+         << (sumMap == sumFlat ? "" : " (SUMS DIFFER)") << "\n";
+}
+
+void benchmarkBatchInsert(size_t n, size_t batch) {
+    vector<int> keys = randomInts(n, 3);
+    vector<int> extra = randomInts(batch, 5);
+    FlatSet<int> one(keys), many(keys);
+    double tOne = timeMs([&] {
+        for (int x : extra) one.insert(x);
+    });
+    double tBatch = timeMs([&] { many.insertBatch(extra.begin(), extra.end()); });
+    cout << "insert " << batch << " into " << n << ": one by one " << tOne << " ms, insertBatch " << tBatch
+         << " ms" << (one.size() == many.size() ? "" : " (SIZES DIFFER)") << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  SORTED FLAT SET / FLAT MAP\n";
+    cout << "========================================\n";
+
+    // ===== SAME USAGE AS main4.cpp =====
+    cout << "\n--- FlatSet ---\n";
+    FlatSet<int> st = {1, 2, 3, 3};
+    st.insert(4);
+    cout << (st.find(8) != st.end());
+    cout << st.empty() << "\n";
+    for (int i : st) cout << i << " ";
+    cout << "\n";
+
+    cout << "\n--- FlatMap ---\n";
+    FlatMap<char, int> mp;
+    vector<char> chr = {'A', 'A', 'B', 'B', 'B', 'C'};
+    for (char c : chr) mp[c]++;
+    for (const pair<char, int> &i : mp) {
+        cout << i.first << " => " << i.second << "\n";
+    }
+
+    // ===== BATCH INSERT + INDEX =====
+    cout << "\n--- insertBatch + buildIndex ---\n";
+    vector<int> more = {10, 7, 3, 8, 7};
+    st.insertBatch(more.begin(), more.end());
+    st.buildIndex();  // Switch lookups to the Eytzinger layout
+    for (int i : st) cout << i << " ";
+    cout << "\ncontains 8? " << st.contains(8) << ", contains 9? " << st.contains(9) << "\n";
+
+    // ===== BENCHMARK =====
+    cout << "\n--- BENCHMARK vs set/map ---\n";
+    size_t maxN = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    for (size_t n = 1000; n <= maxN; n *= 100) {
+        benchmark(n);
+    }
+    cout << "\n";
+    benchmarkBatchInsert(1000000, 10000);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. SORTED VECTOR INSTEAD OF A TREE:
+   - Elements stored contiguously, no per-element allocation
+   - Iteration is a linear scan (the fastest possible)
+   - Single insert/erase is O(n), so batch your changes
+
+2. BULK CONSTRUCTION:
+   - Collect everything, then sort + unique once: O(n log n)
+   - Much faster than n separate set::insert calls
+
+3. BATCHED INSERT:
+   - Sort the new elements, then merge with the existing run
+   - O(k log k + n) instead of k * O(n)
+
+4. BRANCHLESS BINARY SEARCH:
+   - Always halve the range; move the base with a conditional add (cmov)
+   - No branch mispredictions on random keys
+
+5. EYTZINGER LAYOUT:
+   - Keys stored in BFS order: children of k are 2k and 2k+1
+   - Top of the tree stays in cache; next levels can be prefetched
+   - Read-only: rebuilt with buildIndex(), dropped on modification
+
+COMPILATION:
+    g++ -std=c++17 -O2 09_Flat_Set_Map.cpp -o flatset && ./flatset
+
+NEXT STEP: Share a queue between threads without a mutex!
+*/
@@ -0,0 +1,600 @@
+/*
+=============================================================
+     LOCK-FREE QUEUES - PERFORMANCE TUTORIAL
+     File: 10_Lock_Free_Queue.cpp
+=============================================================
+Learn: atomics, memory ordering, ring buffers, false sharing,
+       per-slot sequence numbers, blocking wrappers
+
+main4.cpp declares a queue<int> que;  std::queue is not thread safe, so to
+share it between a producer and a consumer thread you need a mutex:
+
+    mutex m;  queue<int> q;
+    // producer: { lock_guard<mutex> l(m); q.push(x); }
+    // consumer: { lock_guard<mutex> l(m); if(!q.empty()) { x = q.front(); q.pop(); } }
+
+Every operation takes the lock, std::deque allocates as it grows, and
+when threads collide one of them is put to sleep by the OS.
+
+This file builds bounded ring buffers that never lock:
+  SpscQueue  : exactly one producer thread and one consumer thread
+  MpmcQueue  : any number of producers and consumers
+  BlockingQueue<Q> : waits (instead of failing) when full/empty
+*/
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// ============= HELPERS =============
+
+// Two variables written by different threads must not share a 64-byte cache
+// line, otherwise every write by one thread invalidates the other's copy
+// ("false sharing").
+constexpr size_t CACHE_LINE = 64;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();  // Tell the CPU we are spinning
+#else
+    this_thread::yield();
+#endif
+}
+
+inline size_t roundUpPow2(size_t n) {
+    size_t p = 2;
+    while (p < n) p *= 2;
+    return p;
+}
+
+// ============= SPSC QUEUE =============
+
+/*
+Single producer, single consumer ring buffer.
+
+  tail: next slot to write. Only the producer changes it.
+  head: next slot to read.  Only the consumer changes it.
+
+Because each index has exactly one writer, no compare-and-swap is needed:
+the producer writes the element, then publishes it with a release store to
+tail; the consumer sees it with an acquire load.
+
+Each side also keeps a private copy of the other side's index and only
+re-reads the shared atomic when the copy says full/empty. That keeps the
+two cache lines from bouncing between cores on every operation.
+
+Indices grow forever and are masked with (capacity - 1), so full and empty
+are simply tail - head == capacity and tail == head.
+*/
+template <typename T>
+class SpscQueue {
+    private:
+        const size_t capacity;
+        const size_t mask;
+        unique_ptr<T[]> buffer;
+
+        alignas(CACHE_LINE) atomic<size_t> tail{0};
+        size_t cachedHead = 0;  // Producer's view of head
+
+        alignas(CACHE_LINE) atomic<size_t> head{0};
+        size_t cachedTail = 0;  // Consumer's view of tail
+
+    public:
+        explicit SpscQueue(size_t minCapacity)
+            : capacity(roundUpPow2(minCapacity)), mask(capacity - 1), buffer(new T[capacity]) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // ----- Producer side -----
+
+        bool tryPush(const T &value) {
+            size_t t = tail.load(memory_order_relaxed);
+            if (t - cachedHead == capacity) {
+                cachedHead = head.load(memory_order_acquire);
+                if (t - cachedHead == capacity) return false;  // Really full
+            }
+            buffer[t & mask] = value;
+            tail.store(t + 1, memory_order_release);
+            return true;
+        }
+
+        // Pushes up to n items with a single publish; returns how many fit
+        size_t pushBatch(const T *items, size_t n) {
+            size_t t = tail.load(memory_order_relaxed);
+            size_t room = capacity - (t - cachedHead);
+            if (room < n) {
+                cachedHead = head.load(memory_order_acquire);
+                room = capacity - (t - cachedHead);
+            }
+            n = min(n, room);
+            for (size_t i = 0; i < n; i++) buffer[(t + i) & mask] = items[i];
+            tail.store(t + n, memory_order_release);
+            return n;
+        }
+
+        // ----- Consumer side -----
+
+        bool tryPop(T &out) {
+            size_t h = head.load(memory_order_relaxed);
+            if (h == cachedTail) {
+                cachedTail = tail.load(memory_order_acquire);
+                if (h == cachedTail) return false;  // Really empty
+            }
+            out = move(buffer[h & mask]);
+            head.store(h + 1, memory_order_release);
+            return true;
+        }
+
+        // Pops up to maxItems with a single release; returns how many
+        size_t popBatch(T *out, size_t maxItems) {
+            size_t h = head.load(memory_order_relaxed);
+            size_t avail = cachedTail - h;
+            if (avail < maxItems) {
+                cachedTail = tail.load(memory_order_acquire);
+                avail = cachedTail - h;
+            }
+            size_t n = min(maxItems, avail);
+            for (size_t i = 0; i < n; i++) out[i] = move(buffer[(h + i) & mask]);
+            head.store(h + n, memory_order_release);
+            return n;
+        }
+
+        size_t sizeApprox() const {
+            return tail.load(memory_order_relaxed) - head.load(memory_order_relaxed);
+        }
+};
+
+// ============= MPMC QUEUE =============
+
+/*
+Multi-producer, multi-consumer bounded queue (Dmitry Vyukov's design).
+
+Each cell carries a sequence number that says whose turn it is:
+  seq == pos           -> free, the producer that claims ticket pos may write
+  seq == pos + 1       -> full, the consumer that claims ticket pos may read
+  after reading, the consumer sets seq = pos + capacity (free for the next lap)
+
+Producers race for a ticket with compare_exchange on enqueuePos; the winner
+owns that cell exclusively, so the element itself is written without any
+atomic operation. Consumers do the same on dequeuePos.
+*/
+template <typename T>
+class MpmcQueue {
+    private:
+        struct alignas(CACHE_LINE) Cell {
+            atomic<size_t> seq;
+            T value;
+        };
+
+        const size_t capacity;
+        const size_t mask;
+        unique_ptr<Cell[]> cells;
+
+        alignas(CACHE_LINE) atomic<size_t> enqueuePos{0};
+        alignas(CACHE_LINE) atomic<size_t> dequeuePos{0};
+
+    public:
+        explicit MpmcQueue(size_t minCapacity)
+            : capacity(roundUpPow2(minCapacity)), mask(capacity - 1), cells(new Cell[capacity]) {
+            for (size_t i = 0; i < capacity; i++) cells[i].seq.store(i, memory_order_relaxed);
+        }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        bool tryPush(const T &value) {
+            size_t pos = enqueuePos.load(memory_order_relaxed);
+            while (true) {
+                Cell &cell = cells[pos & mask];
+                size_t seq = cell.seq.load(memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    // Cell is free for this lap: try to claim ticket pos
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.seq.store(pos + 1, memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;  // Cell still holds last lap's value: full
+                } else {
+                    pos = enqueuePos.load(memory_order_relaxed);  // Someone else took it
+                }
+            }
+        }
+
+        bool tryPop(T &out) {
+            size_t pos = dequeuePos.load(memory_order_relaxed);
+            while (true) {
+                Cell &cell = cells[pos & mask];
+                size_t seq = cell.seq.load(memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                        out = move(cell.value);
+                        cell.seq.store(pos + capacity, memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;  // Nothing written here yet: empty
+                } else {
+                    pos = dequeuePos.load(memory_order_relaxed);
+                }
+            }
+        }
+
+        /*
+        Batch operations. Cells are handed out one ticket at a time (another
+        producer may own the next cell), so a batch is a loop of tryPush /
+        tryPop that stops at the first full/empty result. It saves the
+        per-call overhead and keeps the caller's loop simple.
+        */
+        size_t pushBatch(const T *items, size_t n) {
+            size_t done = 0;
+            while (done < n && tryPush(items[done])) done++;
+            return done;
+        }
+
+        size_t popBatch(T *out, size_t maxItems) {
+            size_t done = 0;
+            while (done < maxItems && tryPop(out[done])) done++;
+            return done;
+        }
+
+        size_t sizeApprox() const {
+            size_t e = enqueuePos.load(memory_order_relaxed);
+            size_t d = dequeuePos.load(memory_order_relaxed);
+            return e > d ? e - d : 0;
+        }
+};
+
+// ============= BLOCKING WRAPPER =============
+
+/*
+tryPush/tryPop return false when the queue is full/empty. Most programs
+would rather wait. BlockingQueue<Q> keeps the lock-free fast path and only
+falls back to a condition variable after spinning for a short while, so a
+busy queue never touches the mutex, and an idle thread sleeps instead of
+burning a core.
+
+sleepers counts threads that are (about to be) waiting. The other side
+only takes the mutex to notify when sleepers > 0. The two sides are
+
+    waiter:   sleepers++   fence   re-check the queue   wait
+    notifier: publish slot fence   read sleepers        notify if > 0
+
+Without the seq_cst fences both loads may see the old value (the store
+is still in the CPU's store buffer): the waiter misses the item and the
+notifier misses the waiter. With them, at least one side sees the other,
+so the untimed wait can never miss its wake-up.
+*/
+template <typename Q, typename T>
+class BlockingQueue {
+    private:
+        Q q;
+        mutex m;
+        condition_variable cv;
+        atomic<int> sleepers{0};
+
+        static constexpr int spinLimit = 128;
+
+        void wakeAll() {
+            atomic_thread_fence(memory_order_seq_cst);
+            if (sleepers.load(memory_order_seq_cst) > 0) {
+                lock_guard<mutex> lock(m);
+                cv.notify_all();
+            }
+        }
+
+        template <typename Attempt>
+        void waitUntil(Attempt attempt) {
+            for (int spin = 0; spin < spinLimit; spin++) {
+                if (attempt()) return;
+                cpuRelax();
+            }
+            unique_lock<mutex> lock(m);
+            sleepers.fetch_add(1, memory_order_seq_cst);
+            atomic_thread_fence(memory_order_seq_cst);
+            cv.wait(lock, attempt);  // re-checks before the first sleep
+            sleepers.fetch_sub(1, memory_order_seq_cst);
+        }
+
+    public:
+        explicit BlockingQueue(size_t capacity) : q(capacity) {}
+
+        void push(const T &value) {
+            waitUntil([&] { return q.tryPush(value); });
+            wakeAll();
+        }
+
+        T pop() {
+            T out{};
+            waitUntil([&] { return q.tryPop(out); });
+            wakeAll();
+            return out;
+        }
+
+        bool tryPush(const T &value) {
+            bool ok = q.tryPush(value);
+            if (ok) wakeAll();
+            return ok;
+        }
+
+        bool tryPop(T &out) {
+            bool ok = q.tryPop(out);
+            if (ok) wakeAll();
+            return ok;
+        }
+};
+
+// ============= MUTEX BASELINE =============
+
+// The "obvious" thread-safe queue: std::queue + mutex (unbounded)
+template <typename T>
+class MutexQueue {
+    private:
+        queue<T> q;
+        mutex m;
+
+    public:
+        explicit MutexQueue(size_t) {}
+
+        bool tryPush(const T &value) {
+            lock_guard<mutex> lock(m);
+            q.push(value);
+            return true;
+        }
+
+        bool tryPop(T &out) {
+            lock_guard<mutex> lock(m);
+            if (q.empty()) return false;
+            out = q.front();
+            q.pop();
+            return true;
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Spin a few times, then give the core away (matters on machines with few cores)
+struct Backoff {
+    int spins = 0;
+
+    void pause() {
+        if (++spins < 64) cpuRelax();
+        else this_thread::yield();
+    }
+    void reset() {
+        spins = 0;
+    }
+};
+
+// producers x consumers threads move items through the queue; returns Mops/s
+template <typename Queue>
+double throughput(size_t producers, size_t consumers, size_t itemsPerProducer) {
+    Queue q(1024);
+    atomic<long long> checksum{0};
+    size_t total = producers * itemsPerProducer;
+    atomic<size_t> consumed{0};
+    vector<thread> threads;
+
+    double ms = timeMs([&] {
+        for (size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&] {
+                Backoff b;
+                for (size_t i = 1; i <= itemsPerProducer; i++) {
+                    while (!q.tryPush(static_cast<long long>(i))) b.pause();
+                    b.reset();
+                }
+            });
+        }
+        for (size_t c = 0; c < consumers; c++) {
+            threads.emplace_back([&] {
+                Backoff b;
+                long long local = 0, v = 0;
+                while (consumed.load(memory_order_relaxed) < total) {
+                    if (q.tryPop(v)) {
+                        local += v;
+                        consumed.fetch_add(1, memory_order_relaxed);
+                        b.reset();
+                    } else {
+                        b.pause();
+                    }
+                }
+                checksum += local;
+            });
+        }
+        for (thread &t : threads) t.join();
+    });
+
+    long long expected = static_cast<long long>(producers) *
+                         static_cast<long long>(itemsPerProducer) * static_cast<long long>(itemsPerProducer + 1) / 2;
+    if (checksum != expected) cout << "  (CHECKSUM MISMATCH)\n";
+    return static_cast<double>(total) / ms / 1000.0;
+}
+
+// Batched SPSC transfer: producer and consumer move 64 items per call
+double throughputSpscBatch(size_t items) {
+    SpscQueue<long long> q(1024);
+    long long checksum = 0;
+    double ms = timeMs([&] {
+        thread producer([&] {
+            Backoff b;
+            long long buf[64];
+            size_t next = 1;
+            while (next <= items) {
+                size_t n = min<size_t>(64, items - next + 1);
+                for (size_t i = 0; i < n; i++) buf[i] = static_cast<long long>(next + i);
+                size_t sent = 0;
+                while (sent < n) {
+                    size_t k = q.pushBatch(buf + sent, n - sent);
+                    if (k == 0) b.pause();
+                    else b.reset();
+                    sent += k;
+                }
+                next += n;
+            }
+        });
+        Backoff b;
+        long long buf[64];
+        size_t got = 0;
+        while (got < items) {
+            size_t k = q.popBatch(buf, 64);
+            if (k == 0) {
+                b.pause();
+                continue;
+            }
+            b.reset();
+            for (size_t i = 0; i < k; i++) checksum += buf[i];
+            got += k;
+        }
+        producer.join();
+    });
+    long long n = static_cast<long long>(items);
+    if (checksum != n * (n + 1) / 2) cout << "  (CHECKSUM MISMATCH)\n";
+    return static_cast<double>(items) / ms / 1000.0;
+}
+
+// Ping-pong: one item bounces between two threads; returns ns per round trip
+template <typename Queue>
+double roundTripNs(size_t rounds) {
+    Queue ping(16), pong(16);
+    double ms = timeMs([&] {
+        thread echo([&] {
+            Backoff b;
+            long long v = 0;
+            for (size_t i = 0; i < rounds; i++) {
+                while (!ping.tryPop(v)) b.pause();
+                b.reset();
+                while (!pong.tryPush(v)) b.pause();
+                b.reset();
+            }
+        });
+        Backoff b;
+        long long v = 0;
+        for (size_t i = 0; i < rounds; i++) {
+            while (!ping.tryPush(static_cast<long long>(i))) b.pause();
+            b.reset();
+            while (!pong.tryPop(v)) b.pause();
+            b.reset();
+        }
+        echo.join();
+    });
+    return ms * 1e6 / static_cast<double>(rounds);
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  LOCK-FREE QUEUES\n";
+    cout << "========================================\n";
+    cout << "Hardware threads: " << thread::hardware_concurrency() << "\n";
+
+    // ===== SPSC BASICS =====
+    cout << "\n--- SpscQueue ---\n";
+    SpscQueue<int> que(4);
+    for (int i = 1; i <= 5; i++) {
+        cout << "push " << i << (que.tryPush(i) ? " ok" : " (full)") << "\n";
+    }
+    int x;
+    while (que.tryPop(x)) cout << x << " ";
+    cout << "\n";
+
+    // ===== BLOCKING PRODUCER / CONSUMER =====
+    cout << "\n--- BlockingQueue<MpmcQueue> with 2 producers ---\n";
+    BlockingQueue<MpmcQueue<int>, int> jobs(8);
+    thread p1([&] { for (int i = 0; i < 1000; i++) jobs.push(1); });
+    thread p2([&] { for (int i = 0; i < 1000; i++) jobs.push(2); });
+    long long sum = 0;
+    for (int i = 0; i < 2000; i++) sum += jobs.pop();  // Waits when empty
+    p1.join();
+    p2.join();
+    cout << "sum of 2000 items = " << sum << " (expected 3000)\n";
+
+    // ===== BENCHMARK =====
+    size_t items = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000000;
+    cout << "\n--- BENCHMARK: throughput (million items/s) ---\n";
+    cout << "1 producer / 1 consumer, " << items << " items\n";
+    cout << "  mutex + std::queue : " << throughput<MutexQueue<long long>>(1, 1, items) << "\n";
+    cout << "  SpscQueue          : " << throughput<SpscQueue<long long>>(1, 1, items) << "\n";
+    cout << "  SpscQueue (batch)  : " << throughputSpscBatch(items) << "\n";
+    cout << "  MpmcQueue          : " << throughput<MpmcQueue<long long>>(1, 1, items) << "\n";
+    cout << "4 producers / 4 consumers, " << items << " items each\n";
+    cout << "  mutex + std::queue : " << throughput<MutexQueue<long long>>(4, 4, items / 4) << "\n";
+    cout << "  MpmcQueue          : " << throughput<MpmcQueue<long long>>(4, 4, items / 4) << "\n";
+
+    cout << "\n--- BENCHMARK: round-trip latency (ns) ---\n";
+    size_t rounds = 200000;
+    cout << "  mutex + std::queue : " << roundTripNs<MutexQueue<long long>>(rounds) << "\n";
+    cout << "  SpscQueue          : " << roundTripNs<SpscQueue<long long>>(rounds) << "\n";
+    cout << "  MpmcQueue          : " << roundTripNs<MpmcQueue<long long>>(rounds) << "\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ATOMICS AND MEMORY ORDER:
+   - release store: "everything I wrote before this is visible..."
+   - acquire load : "...to whoever reads this value"
+   - That pair is enough to hand an element from one thread to another
+
+2. SPSC RING BUFFER:
+   - One writer per index -> plain loads/stores, no compare-and-swap
+   - Cached copy of the other index avoids touching its cache line
+   - Batch push/pop publish many items with one atomic store
+
+3. FALSE SHARING:
+   - head and tail on the same cache line would ping-pong between cores
+   - alignas(64) puts each on its own line
+
+4. MPMC WITH SEQUENCE NUMBERS:
+   - compare_exchange on the position claims a ticket
+   - The per-cell sequence number says "free" or "full" for this lap
+   - The winner owns the cell; the value itself needs no atomics
+
+5. BLOCKING WRAPPER:
+   - Spin briefly (cheap when the other side is fast)
+   - Then sleep on a condition variable (cheap when it is slow)
+
+6. LIMITS:
+   - Queues are bounded: tryPush fails when full
+   - SpscQueue is only correct with exactly one producer and one consumer
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 10_Lock_Free_Queue.cpp -o queues && ./queues
+    g++ -std=c++17 -O1 -g -pthread -fsanitize=thread 10_Lock_Free_Queue.cpp -o queues_tsan
+
+NEXT STEP: A lock-free stack with safe memory reclamation!
+*/
@@ -0,0 +1,498 @@
+/*
+=============================================================
+     LOCK-FREE STACK - PERFORMANCE TUTORIAL
+     File: 11_Lock_Free_Stack.cpp
+=============================================================
+Learn: Treiber stack, compare-and-swap, the ABA problem,
+       hazard pointers, elimination backoff, ThreadSanitizer
+
+main4.cpp has a commented-out stack drill:
+
+    stack<int> st;
+    st.push(4); st.push(6); st.pop();
+    while(!st.empty()) { cout << st.top(); st.pop(); }
+
+That only works on one thread. A shared std::stack needs a mutex around
+every push and pop, and all threads queue up on that one lock.
+
+A Treiber stack is a linked list whose head is swapped with
+compare-and-swap (CAS). The hard part is freeing popped nodes: another
+thread may still be reading a node we just popped. Hazard pointers solve
+that: before reading a node, a thread publishes "I am using this pointer",
+and nodes are only deleted once nobody has published them.
+*/
+
+#include <iostream>
+#include <vector>
+#include <stack>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// ============= HELPERS =============
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    this_thread::yield();
+#endif
+}
+
+// Cheap per-thread random numbers for picking elimination slots
+inline uint32_t threadRandom() {
+    thread_local uint32_t x = static_cast<uint32_t>(hash<thread::id>{}(this_thread::get_id())) | 1u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// ============= HAZARD POINTERS =============
+
+/*
+Each thread owns one hazard slot. Before dereferencing a shared node it
+stores the node's address in its slot, then re-checks that the node is
+still reachable. While the slot holds the address, nobody frees the node.
+
+A popped node is not deleted immediately; it is "retired" into a
+per-thread list. When the list gets long, the thread scans all hazard
+slots and deletes every retired node that no slot mentions. Cost is
+amortized: one scan per 2 * MAX_THREADS retirements.
+
+Nodes still retired when a thread exits are handed to a shared orphan
+list that other threads adopt on their next scan.
+*/
+class HazardPointers {
+    public:
+        static constexpr size_t MAX_THREADS = 128;
+
+        struct Retired {
+            void *ptr;
+            void (*deleter)(void*);
+        };
+
+    private:
+        struct alignas(64) Slot {
+            atomic<void*> hazard{nullptr};
+            atomic<bool> owned{false};
+        };
+
+        Slot slots[MAX_THREADS];
+        mutex orphanMutex;
+        vector<Retired> orphans;
+
+        // Per-thread state: the claimed slot and the retired list
+        struct ThreadRecord {
+            HazardPointers *domain;
+            Slot *slot = nullptr;
+            vector<Retired> retired;
+
+            explicit ThreadRecord(HazardPointers *d) : domain(d) {
+                for (Slot &s : d->slots) {
+                    bool expected = false;
+                    if (s.owned.compare_exchange_strong(expected, true)) {
+                        slot = &s;
+                        return;
+                    }
+                }
+                cerr << "HazardPointers: more than " << MAX_THREADS << " threads\n";
+                abort();
+            }
+
+            ~ThreadRecord() {
+                domain->scan(retired);
+                if (!retired.empty()) {
+                    lock_guard<mutex> lock(domain->orphanMutex);
+                    domain->orphans.insert(domain->orphans.end(), retired.begin(), retired.end());
+                }
+                slot->hazard.store(nullptr);
+                slot->owned.store(false);
+            }
+        };
+
+        ThreadRecord& record() {
+            thread_local ThreadRecord rec(this);
+            return rec;
+        }
+
+        // Delete every retired pointer that no thread has published
+        void scan(vector<Retired> &retired) {
+            {
+                lock_guard<mutex> lock(orphanMutex);
+                retired.insert(retired.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+            vector<void*> inUse;
+            for (Slot &s : slots) {
+                void *p = s.hazard.load(memory_order_seq_cst);
+                if (p) inUse.push_back(p);
+            }
+            sort(inUse.begin(), inUse.end());
+            size_t kept = 0;
+            for (Retired &r : retired) {
+                if (binary_search(inUse.begin(), inUse.end(), r.ptr)) retired[kept++] = r;
+                else r.deleter(r.ptr);
+            }
+            retired.resize(kept);
+        }
+
+    public:
+        ~HazardPointers() {
+            // No threads are running any more: everything left is garbage
+            for (Retired &r : orphans) r.deleter(r.ptr);
+        }
+
+        static HazardPointers& global() {
+            static HazardPointers domain;
+            return domain;
+        }
+
+        // Publish p as "in use" (seq_cst so the re-check below can't be reordered)
+        void protect(void *p) {
+            record().slot->hazard.store(p, memory_order_seq_cst);
+        }
+
+        void clear() {
+            record().slot->hazard.store(nullptr, memory_order_release);
+        }
+
+        template <typename T>
+        void retire(T *p) {
+            ThreadRecord &rec = record();
+            rec.retired.push_back({p, [](void *q) { delete static_cast<T*>(q); }});
+            if (rec.retired.size() >= 2 * MAX_THREADS) scan(rec.retired);
+        }
+};
+
+// ============= ELIMINATION ARRAY =============
+
+/*
+Under heavy contention most CAS attempts on head fail. But a push and a
+pop that collide can cancel out without touching the stack at all: the
+pusher parks its node in a random exchange slot for a moment, and a popper
+that finds it there takes it directly.
+
+  pusher: CAS slot nullptr -> node, wait a little, then CAS node -> nullptr
+          (if that fails, the slot says TAKEN: the push is done)
+  popper: read slot, CAS node -> TAKEN (success: the node is ours)
+
+The pusher resets TAKEN back to nullptr. Until then nobody else can park
+in that slot, so the pusher can never mistake a new node that happens to
+reuse the same address for its own.
+
+A parked node was never linked into the stack, so no other thread can hold
+a pointer into it and the popper may delete it directly.
+*/
+template <typename Node>
+class EliminationArray {
+    private:
+        static constexpr size_t SLOTS = 8;
+        static constexpr int WAIT_SPINS = 64;
+
+        struct alignas(64) Slot {
+            atomic<Node*> node{nullptr};
+        };
+        Slot slots[SLOTS];
+
+        // Marker address, never dereferenced
+        static inline char takenMarker = 0;
+        static Node* taken() {
+            return reinterpret_cast<Node*>(&takenMarker);
+        }
+
+    public:
+        // True if a popper took the node
+        bool tryHandOff(Node *n) {
+            Slot &s = slots[threadRandom() % SLOTS];
+            Node *expected = nullptr;
+            if (!s.node.compare_exchange_strong(expected, n, memory_order_release, memory_order_relaxed)) {
+                return false;  // Slot busy, go back to the stack
+            }
+            for (int i = 0; i < WAIT_SPINS && s.node.load(memory_order_relaxed) == n; i++) {
+                cpuRelax();
+            }
+            expected = n;
+            if (s.node.compare_exchange_strong(expected, nullptr, memory_order_relaxed)) {
+                return false;  // Nobody came: withdraw the offer
+            }
+            s.node.store(nullptr, memory_order_release);  // Was TAKEN: free the slot again
+            return true;
+        }
+
+        // A node parked by a pusher, or nullptr
+        Node* tryTake() {
+            Slot &s = slots[threadRandom() % SLOTS];
+            Node *n = s.node.load(memory_order_acquire);
+            if (n && n != taken() &&
+                s.node.compare_exchange_strong(n, taken(), memory_order_acquire, memory_order_relaxed)) {
+                return n;
+            }
+            return nullptr;
+        }
+};
+
+// ============= TREIBER STACK =============
+
+/*
+push: new node -> node->next = head -> CAS(head, node->next, node)
+pop : old = head -> CAS(head, old, old->next) -> return old->value
+
+The ABA problem: between reading old and old->next, another thread could
+pop old, free it, and a new node could be allocated at the same address
+and pushed. The CAS would then succeed with a stale next pointer. With a
+hazard pointer on old, old cannot be freed (or reused) while we look at
+it, so ABA cannot happen.
+
+Eliminate = true adds the elimination array as a backoff path whenever a
+CAS on head fails.
+*/
+template <typename T, bool Eliminate = false>
+class LockFreeStack {
+    private:
+        struct Node {
+            T value;
+            Node *next;
+        };
+
+        alignas(64) atomic<Node*> head{nullptr};
+        EliminationArray<Node> elimination;
+
+    public:
+        LockFreeStack() = default;
+        LockFreeStack(const LockFreeStack&) = delete;
+        LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+        ~LockFreeStack() {
+            // Only safe once no other thread uses the stack
+            Node *n = head.load(memory_order_relaxed);
+            while (n) {
+                Node *next = n->next;
+                delete n;
+                n = next;
+            }
+        }
+
+        void push(T value) {
+            Node *n = new Node{move(value), head.load(memory_order_relaxed)};
+            while (!head.compare_exchange_weak(n->next, n, memory_order_release, memory_order_relaxed)) {
+                if constexpr (Eliminate) {
+                    if (elimination.tryHandOff(n)) return;
+                    n->next = head.load(memory_order_relaxed);
+                }
+            }
+        }
+
+        optional<T> pop() {
+            HazardPointers &hp = HazardPointers::global();
+            while (true) {
+                Node *old = head.load(memory_order_acquire);
+                if (!old) {
+                    hp.clear();
+                    return nullopt;
+                }
+                hp.protect(old);
+                if (head.load(memory_order_seq_cst) != old) continue;  // Changed before we protected it
+                Node *next = old->next;  // Safe: old cannot be freed now
+                if (head.compare_exchange_strong(old, next, memory_order_acquire, memory_order_relaxed)) {
+                    hp.clear();
+                    optional<T> result(move(old->value));
+                    hp.retire(old);
+                    return result;
+                }
+                if constexpr (Eliminate) {
+                    hp.clear();
+                    if (Node *n = elimination.tryTake()) {
+                        optional<T> result(move(n->value));
+                        delete n;  // Never linked into the stack: nobody else can see it
+                        return result;
+                    }
+                }
+            }
+        }
+
+        // Only a snapshot: another thread may push/pop right after
+        bool empty() const {
+            return head.load(memory_order_acquire) == nullptr;
+        }
+};
+
+// ============= MUTEX BASELINE =============
+
+template <typename T>
+class MutexStack {
+    private:
+        stack<T> st;
+        mutex m;
+
+    public:
+        void push(T value) {
+            lock_guard<mutex> lock(m);
+            st.push(move(value));
+        }
+
+        optional<T> pop() {
+            lock_guard<mutex> lock(m);
+            if (st.empty()) return nullopt;
+            T v = move(st.top());
+            st.pop();
+            return v;
+        }
+};
+
+// ============= STRESS TEST =============
+
+/*
+Every thread pushes values tagged with its id and a sequence number and
+pops in between. Afterwards the stack is drained, and every value must
+have been popped exactly once. Build with -fsanitize=thread to also check
+for data races and use-after-free in the reclamation code.
+*/
+template <typename Stack>
+bool stressTest(size_t threads, size_t opsPerThread) {
+    Stack st;
+    vector<vector<uint64_t>> popped(threads + 1);
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (uint64_t i = 0; i < opsPerThread; i++) {
+                st.push((uint64_t(t) << 32) | i);
+                if (i % 3 != 0) {
+                    if (auto v = st.pop()) popped[t].push_back(*v);
+                }
+            }
+        });
+    }
+    for (thread &w : workers) w.join();
+    while (auto v = st.pop()) popped[threads].push_back(*v);
+
+    vector<uint64_t> all;
+    for (auto &p : popped) all.insert(all.end(), p.begin(), p.end());
+    sort(all.begin(), all.end());
+    if (all.size() != threads * opsPerThread) return false;
+    size_t k = 0;
+    for (size_t t = 0; t < threads; t++) {
+        for (uint64_t i = 0; i < opsPerThread; i++) {
+            if (all[k++] != ((uint64_t(t) << 32) | i)) return false;
+        }
+    }
+    return true;
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Each thread does push, push, pop, pop ... ; returns million ops per second
+template <typename Stack>
+double scaling(size_t threads, size_t opsPerThread) {
+    Stack st;
+    vector<thread> workers;
+    atomic<long long> sink{0};
+    double ms = timeMs([&] {
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                long long local = 0;
+                for (size_t i = 0; i < opsPerThread / 4; i++) {
+                    st.push(static_cast<long long>(i));
+                    st.push(static_cast<long long>(i));
+                    if (auto v = st.pop()) local += *v;
+                    if (auto v = st.pop()) local += *v;
+                }
+                sink += local;
+            });
+        }
+        for (thread &w : workers) w.join();
+    });
+    return static_cast<double>(threads * opsPerThread) / ms / 1000.0;
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  LOCK-FREE STACK\n";
+    cout << "========================================\n";
+
+    // ===== SAME DRILL AS main4.cpp =====
+    cout << "\n--- push / pop ---\n";
+    LockFreeStack<int> st;
+    st.push(4);
+    st.push(6);
+    st.push(8);
+    st.push(1);
+    st.pop();
+    while (auto top = st.pop()) {
+        cout << *top << " ";
+    }
+    cout << "\n" << "empty: " << st.empty() << "\n";
+
+    // ===== STRESS TEST =====
+    size_t maxThreads = max<size_t>(4, thread::hardware_concurrency());
+    size_t stressOps = argc > 1 ? strtoull(argv[1], nullptr, 10) : 200000;
+    cout << "\n--- STRESS TEST (" << maxThreads << " threads) ---\n";
+    cout << "hazard pointers          : " << (stressTest<LockFreeStack<uint64_t>>(maxThreads, stressOps) ? "PASS" : "FAIL") << "\n";
+    cout << "hazard ptrs + elimination: " << (stressTest<LockFreeStack<uint64_t, true>>(maxThreads, stressOps) ? "PASS" : "FAIL") << "\n";
+
+    // ===== BENCHMARK =====
+    cout << "\n--- BENCHMARK: million ops/s by thread count ---\n";
+    size_t ops = 2000000;
+    for (size_t t = 1; t <= maxThreads; t *= 2) {
+        cout << t << " thread(s): mutex + stack " << scaling<MutexStack<long long>>(t, ops)
+             << ", lock-free " << scaling<LockFreeStack<long long>>(t, ops)
+             << ", lock-free + elimination " << scaling<LockFreeStack<long long, true>>(t, ops) << "\n";
+    }
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. TREIBER STACK:
+   - Linked list; head is an atomic pointer
+   - push/pop retry compare_exchange until head didn't change underneath
+
+2. THE ABA PROBLEM:
+   - head goes A -> B -> A (same address, different node) between our read and CAS
+   - The CAS succeeds but uses a stale next pointer
+
+3. HAZARD POINTERS:
+   - Publish the pointer you are about to read, then re-check it
+   - Popped nodes are retired, and deleted only when no thread publishes them
+   - Bounded garbage: at most ~2 x MAX_THREADS retired nodes per thread
+
+4. ELIMINATION BACKOFF:
+   - On a failed CAS, a push and a pop meet in a side array
+   - They cancel out without touching head, so contention drops
+
+5. TESTING CONCURRENT CODE:
+   - Stress test: every pushed value must be popped exactly once
+   - ThreadSanitizer finds data races the stress test might miss
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 11_Lock_Free_Stack.cpp -o lfstack && ./lfstack
+    g++ -std=c++17 -O1 -g -pthread -fsanitize=thread 11_Lock_Free_Stack.cpp -o lfstack_tsan && ./lfstack_tsan 20000
+
+NEXT STEP: Sort faster than std::sort with radix sort and threads!
+*/
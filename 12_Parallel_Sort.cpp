@@ -0,0 +1,457 @@
+/*
+=============================================================
+     FAST & PARALLEL SORTING - PERFORMANCE TUTORIAL
+     File: 12_Parallel_Sort.cpp
+=============================================================
+Learn: counting sort, LSD radix sort, sample sort, thread pools
+
+main.cpp and main4.cpp sort like this:
+
+    string str4 = "clsdhgegba";
+    sort(str4.begin(), str4.end());
+
+    vector<int> arr = {6,5,4,3,2,1};
+    sort(arr.begin(), arr.end());
+
+std::sort is a comparison sort: O(n log n) compares, one thread. For
+simple keys we can do better:
+  - char data    : only 256 values -> counting sort, O(n)
+  - integer keys : LSD radix sort, a few linear passes, no compares
+  - anything else: sample sort, split the work across a thread pool
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include <iterator>
+#include <array>
+#include <utility>
+using namespace std;
+
+// ============= THREAD POOL =============
+
+/*
+A fixed set of worker threads waiting on a shared task queue.
+Creating threads is expensive, so we create them once and reuse them
+for every parallel sort call. The calling thread always works too, so a
+pool with k workers sorts with k + 1 threads (ThreadPool(0) = 1 thread).
+*/
+class ThreadPool {
+    private:
+        vector<thread> workers;
+        queue<function<void()>> tasks;
+        mutex mtx;
+        condition_variable cv;
+        bool stopping = false;
+
+    public:
+        explicit ThreadPool(size_t threads) {
+            for (size_t i = 0; i < threads; i++) {
+                workers.emplace_back([this] {
+                    while (true) {
+                        function<void()> task;
+                        {
+                            unique_lock<mutex> lock(mtx);
+                            cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                            if (stopping && tasks.empty()) return;
+                            task = move(tasks.front());
+                            tasks.pop();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                lock_guard<mutex> lock(mtx);
+                stopping = true;
+            }
+            cv.notify_all();
+            for (thread &t : workers) t.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const {
+            return workers.size();
+        }
+
+        // Runs body(begin, end) over [0, n) split into chunks of at least
+        // minChunk elements and waits until every chunk is finished.
+        // The calling thread works on the first chunk itself.
+        template <typename Body>
+        void parallelFor(size_t n, size_t minChunk, Body body) {
+            minChunk = max<size_t>(minChunk, 1);
+            size_t chunks = min(workers.size() + 1, (n + minChunk - 1) / minChunk);
+            if (chunks <= 1) {
+                body(size_t(0), n);
+                return;
+            }
+            // Chunk c is [c * n / chunks, (c + 1) * n / chunks): sizes differ
+            // by at most 1 and, since chunks <= n, none is empty
+            size_t pending = chunks - 1;
+            mutex doneMtx;
+            condition_variable doneCv;
+            {
+                lock_guard<mutex> lock(mtx);
+                for (size_t c = 1; c < chunks; c++) {
+                    size_t b = c * n / chunks, e = (c + 1) * n / chunks;
+                    tasks.push([&, b, e] {
+                        body(b, e);
+                        lock_guard<mutex> done(doneMtx);
+                        if (--pending == 0) doneCv.notify_one();
+                    });
+                }
+            }
+            cv.notify_all();
+            body(size_t(0), n / chunks);
+            unique_lock<mutex> lock(doneMtx);
+            doneCv.wait(lock, [&] { return pending == 0; });
+        }
+};
+
+// ============= COUNTING SORT (CHAR DATA) =============
+
+/*
+A string has at most 256 different byte values. Count how often each one
+appears, then write each value out count times. Two linear passes, no
+comparisons at all.
+*/
+void countingSort(string &s) {
+    size_t counts[256] = {};
+    for (unsigned char c : s) counts[c]++;
+    char *out = &s[0];
+    for (int b = 0; b < 256; b++) {
+        memset(out, b, counts[b]);
+        out += counts[b];
+    }
+}
+
+// ============= LSD RADIX SORT (INTEGER KEYS) =============
+
+/*
+Sort by the lowest byte, then the next byte, ... up to the highest byte.
+Each pass is a stable counting sort on one 8-bit digit, so after the last
+pass the keys are fully sorted. 4 passes for int, 8 for long long.
+
+Tricks:
+  - All digit histograms are built in ONE read pass up front
+  - If every key has the same digit in some byte (e.g. small numbers have
+    all-zero high bytes), that pass is skipped
+  - Signed keys: flipping the sign bit maps negative numbers below
+    positive ones, so the unsigned order becomes the signed order
+*/
+template <typename T>
+void radixSort(T *data, size_t n) {
+    static_assert(is_integral_v<T>, "radixSort needs integer keys");
+    using U = make_unsigned_t<T>;
+    constexpr size_t passes = sizeof(T);
+    constexpr U signFlip = is_signed_v<T> ? U(U(1) << (sizeof(T) * 8 - 1)) : U(0);
+    if (n < 2) return;
+
+    auto key = [](T x) { return static_cast<U>(static_cast<U>(x) ^ signFlip); };
+
+    vector<array<size_t, 256>> counts(passes);
+    for (auto &c : counts) c.fill(0);
+    for (size_t i = 0; i < n; i++) {
+        U k = key(data[i]);
+        for (size_t p = 0; p < passes; p++) counts[p][(k >> (p * 8)) & 0xFF]++;
+    }
+
+    vector<T> buffer(n);
+    T *src = data, *dst = buffer.data();
+    for (size_t p = 0; p < passes; p++) {
+        array<size_t, 256> &c = counts[p];
+        if (c[(key(src[0]) >> (p * 8)) & 0xFF] == n) continue;  // Same digit everywhere
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; b++) {
+            size_t count = c[b];
+            c[b] = sum;  // Now the first output index for digit b
+            sum += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            T x = src[i];
+            dst[c[(key(x) >> (p * 8)) & 0xFF]++] = x;
+        }
+        swap(src, dst);
+    }
+    if (src != data) memcpy(data, src, n * sizeof(T));
+}
+
+template <typename T>
+void radixSort(vector<T> &v) {
+    radixSort(v.data(), v.size());
+}
+
+// ============= PARALLEL SAMPLE SORT (ANY COMPARATOR) =============
+
+/*
+1. Sample: pick evenly spaced elements, sort them, and take every k-th
+   one as a splitter. B - 1 splitters cut the key range into B buckets of
+   roughly equal size.
+2. Classify: each thread finds the bucket of every element in its chunk
+   (binary search over the splitters) and counts bucket sizes.
+3. Scatter: prefix sums over (bucket, chunk) give every thread its own
+   output range per bucket, so all threads can copy without locks.
+4. Sort buckets: each bucket is independent; std::sort them in parallel.
+
+Element type must be default-constructible (for the scratch buffer).
+Not stable, same as std::sort.
+*/
+template <typename It, typename Compare>
+void parallelSort(It first, It last, Compare comp, ThreadPool &pool) {
+    using T = typename iterator_traits<It>::value_type;
+    size_t n = static_cast<size_t>(last - first);
+    size_t threads = pool.size() + 1;
+    if (threads == 1 || n < (size_t(1) << 15)) {
+        sort(first, last, comp);
+        return;
+    }
+
+    // 1. Splitters from an oversampled, sorted sample
+    const size_t buckets = threads * 4;
+    const size_t oversample = 32;
+    vector<T> sample;
+    sample.reserve(buckets * oversample);
+    for (size_t i = 0; i < buckets * oversample; i++) {
+        sample.push_back(first[static_cast<ptrdiff_t>(i * n / (buckets * oversample))]);
+    }
+    sort(sample.begin(), sample.end(), comp);
+    vector<T> splitters;
+    for (size_t b = 1; b < buckets; b++) splitters.push_back(sample[b * oversample]);
+
+    // 2. Classify every element, counting per (chunk, bucket)
+    size_t chunks = threads;
+    size_t chunkSize = (n + chunks - 1) / chunks;
+    vector<uint32_t> bucketOf(n);
+    vector<vector<size_t>> counts(chunks, vector<size_t>(buckets, 0));
+    pool.parallelFor(chunks, 1, [&](size_t cb, size_t ce) {
+        for (size_t c = cb; c < ce; c++) {
+            size_t b0 = c * chunkSize, b1 = min(n, b0 + chunkSize);
+            for (size_t i = b0; i < b1; i++) {
+                auto pos = upper_bound(splitters.begin(), splitters.end(), first[static_cast<ptrdiff_t>(i)], comp);
+                uint32_t b = static_cast<uint32_t>(pos - splitters.begin());
+                bucketOf[i] = b;
+                counts[c][b]++;
+            }
+        }
+    });
+
+    // 3. Offsets: bucket-major, so each bucket ends up contiguous
+    vector<size_t> bucketStart(buckets + 1, 0);
+    vector<vector<size_t>> offset(chunks, vector<size_t>(buckets));
+    size_t sum = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        bucketStart[b] = sum;
+        for (size_t c = 0; c < chunks; c++) {
+            offset[c][b] = sum;
+            sum += counts[c][b];
+        }
+    }
+    bucketStart[buckets] = n;
+
+    vector<T> scratch(n);
+    pool.parallelFor(chunks, 1, [&](size_t cb, size_t ce) {
+        for (size_t c = cb; c < ce; c++) {
+            size_t b0 = c * chunkSize, b1 = min(n, b0 + chunkSize);
+            vector<size_t> &out = offset[c];
+            for (size_t i = b0; i < b1; i++) {
+                scratch[out[bucketOf[i]]++] = move(first[static_cast<ptrdiff_t>(i)]);
+            }
+        }
+    });
+
+    // 4. Sort each bucket and move it back into place
+    pool.parallelFor(buckets, 1, [&](size_t bb, size_t be) {
+        for (size_t b = bb; b < be; b++) {
+            auto s = scratch.begin() + static_cast<ptrdiff_t>(bucketStart[b]);
+            auto e = scratch.begin() + static_cast<ptrdiff_t>(bucketStart[b + 1]);
+            sort(s, e, comp);
+            move(s, e, first + static_cast<ptrdiff_t>(bucketStart[b]));
+        }
+    });
+}
+
+template <typename It>
+void parallelSort(It first, It last, ThreadPool &pool) {
+    parallelSort(first, last, less<>(), pool);
+}
+
+// ============= PICK THE RIGHT SORT =============
+
+/*
+fastSort chooses at compile time:
+  string / vector<char>       -> counting sort
+  vector of integers          -> radix sort (std::sort for tiny inputs)
+  anything else               -> std::sort
+*/
+inline void fastSort(string &s) {
+    if (s.size() < 64) sort(s.begin(), s.end());
+    else countingSort(s);
+}
+
+template <typename T>
+void fastSort(vector<T> &v) {
+    if constexpr (is_integral_v<T> && !is_same_v<T, bool>) {
+        if (v.size() < 256) sort(v.begin(), v.end());
+        else radixSort(v);
+    } else {
+        sort(v.begin(), v.end());
+    }
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+uint64_t nextRandom(uint64_t &x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+vector<int> makeData(size_t n, const string &dist) {
+    vector<int> v(n);
+    uint64_t x = 88172645463325252ull;
+    for (size_t i = 0; i < n; i++) {
+        if (dist == "uniform") v[i] = static_cast<int>(nextRandom(x));
+        else if (dist == "few-unique") v[i] = static_cast<int>(nextRandom(x) % 16);
+        else if (dist == "sorted") v[i] = static_cast<int>(i);
+        else v[i] = static_cast<int>(nextRandom(x) % 1000) * static_cast<int>(nextRandom(x) % 1000);  // skewed
+    }
+    return v;
+}
+
+void benchmarkInts(size_t n, const string &dist, const vector<size_t> &threadCounts) {
+    vector<int> original = makeData(n, dist);
+    vector<int> expected = original;
+    double tStd = timeMs([&] { sort(expected.begin(), expected.end()); });
+
+    vector<int> v = original;
+    double tRadix = timeMs([&] { radixSort(v); });
+    bool ok = v == expected;
+
+    cout << n << " ints, " << dist << ": std::sort " << tStd << " ms, radix " << tRadix << " ms";
+    for (size_t t : threadCounts) {
+        ThreadPool pool(t - 1);
+        v = original;
+        // Comparator version: the path a non-integer key would take
+        double tPar = timeMs([&] { parallelSort(v.begin(), v.end(), less<int>(), pool); });
+        ok = ok && v == expected;
+        cout << ", sample sort x" << t << " " << tPar << " ms";
+    }
+    cout << (ok ? "" : "  (RESULTS DIFFER)") << "\n";
+}
+
+void benchmarkChars(size_t n) {
+    string s(n, ' ');
+    uint64_t x = 1;
+    for (char &c : s) c = static_cast<char>('a' + nextRandom(x) % 26);
+    string a = s, b = s;
+    double tStd = timeMs([&] { sort(a.begin(), a.end()); });
+    double tCount = timeMs([&] { countingSort(b); });
+    cout << n << " chars: std::sort " << tStd << " ms, counting sort " << tCount << " ms"
+         << (a == b ? "" : "  (RESULTS DIFFER)") << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  FAST & PARALLEL SORTING\n";
+    cout << "========================================\n";
+
+    // ===== SAME EXAMPLES AS main.cpp / main4.cpp =====
+    cout << "\n--- fastSort ---\n";
+    string str4 = "clsdhgegba";
+    fastSort(str4);  // Counting sort for characters
+    cout << str4 << "\n";
+
+    vector<int> arr = {6, 5, -4, 3, 2, 1};
+    radixSort(arr);  // Works with negative numbers too
+    for (int i : arr) cout << i << " ";
+    cout << "\n";
+
+    // ===== PARALLEL WITH A CUSTOM COMPARATOR =====
+    cout << "\n--- parallelSort (descending) ---\n";
+    ThreadPool pool(max(1u, thread::hardware_concurrency()) - 1);
+    vector<string> names = {"Nithwin", "BMW", "Yamaha", "Honda", "Purple", "Black"};
+    parallelSort(names.begin(), names.end(), greater<string>(), pool);
+    for (const string &s : names) cout << s << " ";
+    cout << "\n";
+
+    // ===== BENCHMARK =====
+    size_t maxN = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    vector<size_t> threadCounts;
+    size_t hw = max(1u, thread::hardware_concurrency());
+    for (size_t t = 1; t < hw; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(hw);
+
+    cout << "\n--- BENCHMARK: integers ---\n";
+    for (size_t n = 1000000; n <= maxN; n *= 10) {
+        for (const char *dist : {"uniform", "skewed", "few-unique", "sorted"}) {
+            benchmarkInts(n, dist, threadCounts);
+        }
+    }
+    cout << "\n--- BENCHMARK: characters ---\n";
+    benchmarkChars(maxN * 10);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. COUNTING SORT:
+   - Works when keys come from a small range (256 chars)
+   - Count, then write out: O(n + 256), no comparisons
+
+2. LSD RADIX SORT:
+   - One stable counting pass per byte, lowest byte first
+   - O(n * bytes): beats O(n log n) for large n
+   - Skip bytes that are identical in every key
+   - Flip the sign bit to sort signed integers
+
+3. SAMPLE SORT:
+   - Splitters from a sorted sample cut the data into balanced buckets
+   - Classify + scatter + sort buckets: every step runs in parallel
+   - Works with any comparator (strings, structs, descending order)
+
+4. THREAD POOL:
+   - Threads are created once and reused for every sort
+   - parallelFor splits an index range into one chunk per thread
+
+5. CHOOSING:
+   - Tiny inputs: std::sort (setup costs dominate)
+   - Integers: radix; chars: counting; general: sample sort
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 12_Parallel_Sort.cpp -o psort && ./psort
+
+NEXT STEP: Reverse and transform strings with SIMD!
+*/
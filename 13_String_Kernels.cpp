@@ -0,0 +1,626 @@
+/*
+=============================================================
+     SIMD STRING KERNELS - PERFORMANCE TUTORIAL
+     File: 13_String_Kernels.cpp
+=============================================================
+Learn: byte shuffles, branch-free range checks, SIMD counting,
+       table lookups with pshufb, runtime CPU dispatch
+
+main.cpp reverses a string like this:
+
+    string str = "Nithwin";
+    string tmp = str;
+    reverse(str.begin(), str.end());
+
+and main4.cpp (commented out) lowercases one char at a time:
+
+    for(int i = 0; i < str.length(); i++){
+        if(str[i] >= 'A' && str[i] <= 'Z'){
+            str[i] = str[i]+32;
+        }
+    }
+
+Both touch one byte per step, and the lowercase loop has a branch that
+the CPU mispredicts on mixed-case text. This file does the same jobs
+16 (SSE2) or 32 (AVX2) bytes per instruction:
+  - reverse      : load a block from each end, reverse the bytes with a
+                   shuffle, store them swapped
+  - case convert : compute "is this byte a letter" for all bytes at once
+                   and flip bit 5 (the 32) only where it is
+  - count class  : count digits / letters / spaces without isdigit()
+  - translate    : map every byte through a 256-entry table (like tr)
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cstdint>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define KERNELS_HAVE_X86 1
+#endif
+using namespace std;
+
+// ============= CHARACTER CLASSES =============
+
+/*
+Every class is one to three byte ranges [lo, hi]. Ranges are easy to test
+with SIMD (see inRange below), unlike a call to isdigit() per byte.
+ASCII only: bytes >= 128 never belong to a class.
+*/
+enum class CharClass { Digit, Alpha, Upper, Lower, Space, Alnum };
+
+struct ClassRanges {
+    unsigned char lo[3];
+    unsigned char hi[3];
+    int count;
+};
+
+ClassRanges classRanges(CharClass cls) {
+    switch (cls) {
+        case CharClass::Digit: return {{'0'}, {'9'}, 1};
+        case CharClass::Alpha: return {{'A', 'a'}, {'Z', 'z'}, 2};
+        case CharClass::Upper: return {{'A'}, {'Z'}, 1};
+        case CharClass::Lower: return {{'a'}, {'z'}, 1};
+        case CharClass::Space: return {{'\t', ' '}, {'\r', ' '}, 2};  // \t \n \v \f \r and ' '
+        case CharClass::Alnum: return {{'0', 'A', 'a'}, {'9', 'Z', 'z'}, 3};
+    }
+    return {{}, {}, 0};
+}
+
+// ============= SCALAR KERNELS =============
+
+/*
+The scalar versions are the fallback for CPUs without SIMD and handle the
+leftover tail (< one block) of the SIMD versions. They are already
+branch-free: (c - 'A') < 26 is a single unsigned compare, and the result
+is used as a number instead of in an if.
+*/
+void reverseScalar(char *p, size_t n) {
+    reverse(p, p + n);
+}
+
+void toLowerScalar(char *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = static_cast<unsigned char>(p[i]);
+        p[i] = static_cast<char>(c ^ (static_cast<unsigned char>(c - 'A') < 26) << 5);
+    }
+}
+
+void toUpperScalar(char *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = static_cast<unsigned char>(p[i]);
+        p[i] = static_cast<char>(c ^ (static_cast<unsigned char>(c - 'a') < 26) << 5);
+    }
+}
+
+size_t countClassScalar(const char *p, size_t n, CharClass cls) {
+    ClassRanges r = classRanges(cls);
+    unsigned char table[256] = {};
+    for (int k = 0; k < r.count; k++) {
+        for (int c = r.lo[k]; c <= r.hi[k]; c++) table[c] = 1;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) total += table[static_cast<unsigned char>(p[i])];
+    return total;
+}
+
+void translateScalar(char *p, size_t n, const unsigned char *table) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = static_cast<char>(table[static_cast<unsigned char>(p[i])]);
+    }
+}
+
+// ============= SIMD KERNELS (x86) =============
+
+/*
+RANGE CHECK WITHOUT BRANCHES:
+SIMD compares are signed, so "lo <= x <= hi" is done in one compare by
+shifting the range down to the very bottom of the signed range:
+    t = x + (0x80 - lo)          lo maps to -128, hi to -128 + (hi - lo)
+    inside = t < -128 + (hi - lo) + 1
+The result is 0xFF for bytes inside the range and 0x00 outside.
+
+COUNTING:
+0xFF is -1, so "acc = acc - mask" adds 1 per matching byte to each of
+the 16/32 byte counters. They would overflow after 255 blocks, so every
+255 blocks sad_epu8 (sum of absolute differences against zero) adds the
+byte counters up into 64-bit totals.
+
+TRANSLATE:
+pshufb looks up 16 bytes at once in a 16-byte table. A 256-entry table
+is 16 rows of 16: look up the low nibble in a row and keep the result
+where the high nibble equals the row number. Doing all 16 rows costs
+about as much as the scalar loop, but real tables (tr, rot13, case maps)
+change only a few rows, and rows that map to themselves can be skipped.
+With more than MAX_TRANSLATE_ROWS changed rows the scalar loop is used.
+SSE2 has no pshufb, so the SSE2 level always uses the scalar translate.
+*/
+#ifdef KERNELS_HAVE_X86
+
+constexpr int MAX_TRANSLATE_ROWS = 6;
+
+inline __m128i inRange16(__m128i v, unsigned char lo, unsigned char hi) {
+    __m128i t = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm_cmplt_epi8(t, _mm_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1)));
+}
+
+// Reverse the 16 bytes of a register using only SSE2 shuffles
+inline __m128i reverse16(__m128i v) {
+    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));       // Reverse the 4 dwords
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));     // Swap words in each dword
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));  // Swap bytes in each word
+}
+
+void reverseSSE2(char *p, size_t n) {
+    char *lo = p, *hi = p + n;
+    while (hi - lo >= 32) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lo), reverse16(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hi - 16), reverse16(a));
+        lo += 16;
+        hi -= 16;
+    }
+    reverseScalar(lo, static_cast<size_t>(hi - lo));
+}
+
+// Flip bit 5 of every byte in [first, first + 25]
+inline __m128i flipCase16(__m128i v, unsigned char first) {
+    __m128i letters = inRange16(v, first, static_cast<unsigned char>(first + 25));
+    return _mm_xor_si128(v, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+
+void toLowerSSE2(char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), flipCase16(v, 'A'));
+    }
+    toLowerScalar(p + i, n - i);
+}
+
+void toUpperSSE2(char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), flipCase16(v, 'a'));
+    }
+    toUpperScalar(p + i, n - i);
+}
+
+size_t countClassSSE2(const char *p, size_t n, CharClass cls) {
+    ClassRanges r = classRanges(cls);
+    const __m128i zero = _mm_setzero_si128();
+    size_t total = 0, i = 0;
+    while (n - i >= 16) {
+        size_t blocks = min<size_t>((n - i) / 16, 255);
+        __m128i acc = zero;
+        for (size_t b = 0; b < blocks; b++, i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i hit = zero;
+            for (int k = 0; k < r.count; k++) hit = _mm_or_si128(hit, inRange16(v, r.lo[k], r.hi[k]));
+            acc = _mm_sub_epi8(acc, hit);
+        }
+        __m128i sums = _mm_sad_epu8(acc, zero);
+        total += static_cast<size_t>(_mm_extract_epi16(sums, 0) + _mm_extract_epi16(sums, 4));
+    }
+    return total + countClassScalar(p + i, n - i, cls);
+}
+
+__attribute__((target("avx2")))
+inline __m256i inRange32(__m256i v, unsigned char lo, unsigned char hi) {
+    __m256i t = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + (hi - lo) + 1)), t);
+}
+
+// pshufb reverses within each 16-byte lane, then the two lanes are swapped
+__attribute__((target("avx2")))
+inline __m256i reverse32(__m256i v) {
+    const __m256i order = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                           15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order), _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+__attribute__((target("avx2")))
+void reverseAVX2(char *p, size_t n) {
+    char *lo = p, *hi = p + n;
+    while (hi - lo >= 64) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lo));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hi - 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lo), reverse32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hi - 32), reverse32(a));
+        lo += 32;
+        hi -= 32;
+    }
+    reverseSSE2(lo, static_cast<size_t>(hi - lo));
+}
+
+__attribute__((target("avx2")))
+inline __m256i flipCase32(__m256i v, unsigned char first) {
+    __m256i letters = inRange32(v, first, static_cast<unsigned char>(first + 25));
+    return _mm256_xor_si256(v, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+void toLowerAVX2(char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), flipCase32(v, 'A'));
+    }
+    toLowerSSE2(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void toUpperAVX2(char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), flipCase32(v, 'a'));
+    }
+    toUpperSSE2(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+size_t countClassAVX2(const char *p, size_t n, CharClass cls) {
+    ClassRanges r = classRanges(cls);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t total = 0, i = 0;
+    while (n - i >= 32) {
+        size_t blocks = min<size_t>((n - i) / 32, 255);
+        __m256i acc = zero;
+        for (size_t b = 0; b < blocks; b++, i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            __m256i hit = zero;
+            for (int k = 0; k < r.count; k++) hit = _mm256_or_si256(hit, inRange32(v, r.lo[k], r.hi[k]));
+            acc = _mm256_sub_epi8(acc, hit);
+        }
+        __m256i sums = _mm256_sad_epu8(acc, zero);
+        total += static_cast<size_t>(_mm256_extract_epi16(sums, 0) + _mm256_extract_epi16(sums, 4) +
+                                     _mm256_extract_epi16(sums, 8) + _mm256_extract_epi16(sums, 12));
+    }
+    return total + countClassSSE2(p + i, n - i, cls);
+}
+
+__attribute__((target("avx2")))
+void translateAVX2(char *p, size_t n, const unsigned char *table) {
+    // Rows the table leaves unchanged need no work: start from the input
+    // and only patch in the rows that actually map somewhere else
+    __m256i rows[16];
+    int active[16], count = 0;
+    for (int h = 0; h < 16; h++) {
+        bool identity = true;
+        for (int c = 0; c < 16; c++) identity &= table[16 * h + c] == 16 * h + c;
+        if (identity) continue;
+        rows[count] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * h)));
+        active[count++] = h;
+    }
+    if (count > MAX_TRANSLATE_ROWS) {
+        translateScalar(p, n, table);
+        return;
+    }
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i lo = _mm256_and_si256(v, lowNibble);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble);
+        __m256i out = v;
+        for (int k = 0; k < count; k++) {
+            __m256i inRow = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(static_cast<char>(active[k])));
+            out = _mm256_blendv_epi8(out, _mm256_shuffle_epi8(rows[k], lo), inRow);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), out);
+    }
+    translateScalar(p + i, n - i, table);
+}
+
+#endif
+
+// ============= RUNTIME DISPATCH =============
+
+/*
+One set of function pointers per instruction-set level. kernels() picks
+the best level once; kernelLevels() lists every level the running CPU
+supports so the benchmark can compare them.
+*/
+struct StringKernels {
+    void (*reverse)(char*, size_t);
+    void (*toLower)(char*, size_t);
+    void (*toUpper)(char*, size_t);
+    size_t (*countClass)(const char*, size_t, CharClass);
+    void (*translate)(char*, size_t, const unsigned char*);
+    const char *name;
+};
+
+vector<StringKernels> kernelLevels() {
+    vector<StringKernels> levels;
+    levels.push_back({reverseScalar, toLowerScalar, toUpperScalar, countClassScalar, translateScalar, "scalar"});
+#ifdef KERNELS_HAVE_X86
+    levels.push_back({reverseSSE2, toLowerSSE2, toUpperSSE2, countClassSSE2, translateScalar, "SSE2"});
+    if (__builtin_cpu_supports("avx2")) {
+        levels.push_back({reverseAVX2, toLowerAVX2, toUpperAVX2, countClassAVX2, translateAVX2, "AVX2"});
+    }
+#endif
+    return levels;
+}
+
+const StringKernels& kernels() {
+    static const StringKernels best = kernelLevels().back();
+    return best;
+}
+
+// ============= STRING API =============
+
+void reverseString(string &s) {
+    kernels().reverse(&s[0], s.size());
+}
+
+void toLower(string &s) {
+    kernels().toLower(&s[0], s.size());
+}
+
+void toUpper(string &s) {
+    kernels().toUpper(&s[0], s.size());
+}
+
+size_t countClass(string_view s, CharClass cls) {
+    return kernels().countClass(s.data(), s.size(), cls);
+}
+
+// Like the Unix tr command: every byte from[i] becomes to[i]
+struct TranslateTable {
+    unsigned char map[256];
+};
+
+TranslateTable makeTranslate(string_view from, string_view to) {
+    TranslateTable t;
+    for (int c = 0; c < 256; c++) t.map[c] = static_cast<unsigned char>(c);
+    for (size_t i = 0; i < from.size() && i < to.size(); i++) {
+        t.map[static_cast<unsigned char>(from[i])] = static_cast<unsigned char>(to[i]);
+    }
+    return t;
+}
+
+void translate(string &s, const TranslateTable &t) {
+    kernels().translate(&s[0], s.size(), t.map);
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// The loop from main4.cpp
+void toLowerOriginal(char *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] >= 'A' && p[i] <= 'Z') {
+            p[i] = static_cast<char>(p[i] + 32);
+        }
+    }
+}
+
+size_t countDigitsOriginal(const char *p, size_t n) {
+    return static_cast<size_t>(count_if(p, p + n, [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; }));
+}
+
+// <cctype> reference for every class (the "C" locale matches classRanges)
+size_t countClassOriginal(const char *p, size_t n, CharClass cls) {
+    int (*test)(int) = nullptr;
+    switch (cls) {
+        case CharClass::Digit: test = isdigit; break;
+        case CharClass::Alpha: test = isalpha; break;
+        case CharClass::Upper: test = isupper; break;
+        case CharClass::Lower: test = islower; break;
+        case CharClass::Space: test = isspace; break;
+        case CharClass::Alnum: test = isalnum; break;
+    }
+    return static_cast<size_t>(count_if(p, p + n, [test](char c) { return test(static_cast<unsigned char>(c)) != 0; }));
+}
+
+// Mixed text: letters of both cases, digits, spaces and punctuation
+string makeText(size_t n) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 \t\n.,;:!?";
+    string s(n, ' ');
+    unsigned seed = 12345;
+    for (char &c : s) {
+        seed = seed * 1103515245u + 12345u;
+        c = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+    return s;
+}
+
+// Counts are added here so the counting loops are not optimized away
+size_t countSink = 0;
+
+// Runs op on buf often enough to process ~targetBytes, returns GB/s
+template <typename Op>
+double throughput(string &buf, size_t targetBytes, Op op) {
+    size_t reps = max<size_t>(1, targetBytes / buf.size());
+    double ms = timeMs([&] {
+        for (size_t r = 0; r < reps; r++) op(&buf[0], buf.size());
+    });
+    return double(buf.size()) * double(reps) / (ms * 1e6);
+}
+
+string sizeName(size_t bytes) {
+    if (bytes >= (size_t(1) << 30)) return to_string(bytes >> 30) + " GB";
+    if (bytes >= (size_t(1) << 20)) return to_string(bytes >> 20) + " MB";
+    return to_string(bytes >> 10) + " KB";
+}
+
+void benchmark(size_t bytes, const vector<StringKernels> &levels) {
+    const size_t target = 256u << 20;
+    string text = makeText(bytes);
+    string buf = text;
+    TranslateTable rot13 = makeTranslate("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                                         "nopqrstuvwxyzabcdefghijklmNOPQRSTUVWXYZABCDEFGHIJKLM");
+
+    // Every byte value, for the translate tables that touch bytes >= 0x80
+    string allBytes(bytes, '\0');
+    for (size_t i = 0; i < allBytes.size(); i++) allBytes[i] = static_cast<char>(i * 7);
+    TranslateTable flipHigh, invert;
+    for (int c = 0; c < 256; c++) {
+        flipHigh.map[c] = static_cast<unsigned char>(c >= 0xC0 ? c ^ 0x20 : c);  // 4 rows changed
+        invert.map[c] = static_cast<unsigned char>(255 - c);                     // all 16 rows changed
+    }
+    const CharClass classes[] = {CharClass::Digit, CharClass::Alpha, CharClass::Upper,
+                                 CharClass::Lower, CharClass::Space, CharClass::Alnum};
+
+    // Correctness: every level must agree with the baseline
+    bool ok = true;
+    for (const StringKernels &k : levels) {
+        string a = text, b = text;
+        reverse(a.begin(), a.end());
+        k.reverse(&b[0], b.size());
+        ok = ok && a == b;
+        a = text, b = text;
+        toLowerOriginal(&a[0], a.size());
+        k.toLower(&b[0], b.size());
+        ok = ok && a == b;
+        a = text, b = text;
+        for (char &c : a) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        k.toUpper(&b[0], b.size());
+        ok = ok && a == b;
+        for (const string &input : {text, allBytes}) {
+            for (const TranslateTable *t : {&rot13, &flipHigh, &invert}) {
+                a = input, b = input;
+                translateScalar(&a[0], a.size(), t->map);
+                k.translate(&b[0], b.size(), t->map);
+                ok = ok && a == b;
+            }
+            for (CharClass cls : classes) {
+                ok = ok && k.countClass(input.data(), input.size(), cls) ==
+                           countClassOriginal(input.data(), input.size(), cls);
+            }
+        }
+    }
+
+    cout << sizeName(bytes) << (ok ? "" : "  (RESULTS DIFFER)") << "  [GB/s]\n";
+
+    cout << "  reverse     std::reverse " << throughput(buf, target, [](char *p, size_t n) { reverse(p, p + n); });
+    for (const StringKernels &k : levels) cout << "  " << k.name << " " << throughput(buf, target, k.reverse);
+    cout << "\n";
+
+    cout << "  toLower     original     " << throughput(buf, target, toLowerOriginal);
+    for (const StringKernels &k : levels) {
+        cout << "  " << k.name << " " << throughput(buf, target, k.toLower);
+        buf = text;
+    }
+    cout << "\n";
+
+    cout << "  countDigit  isdigit      "
+         << throughput(buf, target, [&](char *p, size_t n) { countSink += countDigitsOriginal(p, n); });
+    for (const StringKernels &k : levels) {
+        cout << "  " << k.name << " "
+             << throughput(buf, target, [&](char *p, size_t n) { countSink += k.countClass(p, n, CharClass::Digit); });
+    }
+    cout << "\n";
+
+    cout << "  translate   (rot13)     ";
+    for (const StringKernels &k : levels) {
+        cout << "  " << k.name << " "
+             << throughput(buf, target, [&](char *p, size_t n) { k.translate(p, n, rot13.map); });
+    }
+    cout << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  SIMD STRING KERNELS\n";
+    cout << "========================================\n";
+    cout << "Best kernels: " << kernels().name << "\n";
+
+    // ===== SAME EXAMPLE AS main.cpp =====
+    cout << "\n--- reverseString ---\n";
+    string str = "Nithwin";
+    string tmp = str;
+    reverseString(str);
+    cout << "Original: " << tmp << "\n";
+    cout << "Reversed: " << str << "\n";
+
+    // ===== SAME EXAMPLE AS main4.cpp =====
+    cout << "\n--- toLower / toUpper ---\n";
+    string s = "Hello This Is Programming";
+    toLower(s);
+    cout << s << "\n";
+    toUpper(s);
+    cout << s << "\n";
+
+    // ===== CHARACTER CLASSES =====
+    cout << "\n--- countClass ---\n";
+    string line = "Order 66 shipped at 10:45 to Room 2B";
+    cout << "digits: " << countClass(line, CharClass::Digit)
+         << ", letters: " << countClass(line, CharClass::Alpha)
+         << ", spaces: " << countClass(line, CharClass::Space) << "\n";
+
+    // ===== TRANSLATE =====
+    cout << "\n--- translate (tr \"aeiou\" \"AEIOU\") ---\n";
+    string t = "performance tutorial";
+    translate(t, makeTranslate("aeiou", "AEIOU"));
+    cout << t << "\n";
+
+    // ===== BENCHMARK =====
+    // Largest buffer in MB: ./kernels 1024 runs up to 1 GB
+    cout << "\n--- BENCHMARK ---\n";
+    size_t maxBytes = (argc > 1 ? strtoull(argv[1], nullptr, 10) : 64) << 20;
+    vector<StringKernels> levels = kernelLevels();
+    for (size_t bytes : {size_t(1) << 10, size_t(64) << 10, size_t(1) << 20, size_t(64) << 20}) {
+        if (bytes <= maxBytes) benchmark(bytes, levels);
+    }
+    if (maxBytes > (size_t(64) << 20)) benchmark(maxBytes, levels);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. SIMD REVERSE:
+   - Load one block from the front and one from the back
+   - Reverse the bytes inside each register with shuffles
+   - Store them swapped, move both pointers inward
+
+2. BRANCH-FREE RANGE CHECKS:
+   - x + (0x80 - lo) moves the range [lo, hi] to the bottom of the signed range
+   - One signed compare tests 16/32 bytes at once
+   - The 0xFF/0x00 mask selects where to flip bit 5 (the +32 from main4.cpp)
+
+3. SIMD COUNTING:
+   - Subtract the 0xFF (-1) mask to count matches per byte lane
+   - Flush with sad_epu8 every 255 blocks before the lanes overflow
+
+4. TABLE LOOKUP:
+   - pshufb = 16 parallel lookups in a 16-byte table
+   - 256 entries = 16 rows; pick the row by the high nibble
+
+5. RUNTIME DISPATCH:
+   - One function table per level (scalar, SSE2, AVX2)
+   - target("avx2") + __builtin_cpu_supports: no -mavx2 needed
+   - Scalar code handles the tails and non-x86 builds
+
+COMPILATION:
+    g++ -std=c++17 -O2 13_String_Kernels.cpp -o kernels && ./kernels
+    ./kernels 1024   (up to 1 GB buffers)
+
+NEXT STEP: Find substrings faster than string::find!
+*/
@@ -0,0 +1,547 @@
+/*
+=============================================================
+     ROPE (PIECE-TREE STRING) - PERFORMANCE TUTORIAL
+     File: 15_Rope.cpp
+=============================================================
+Learn: piece tables, implicit treaps, persistent (shared) trees,
+       O(log n) editing, string_view chunk iteration
+
+The strings() demo in main.cpp edits one std::string:
+
+    s.erase(6, s.length());
+    s.replace(0, 5, "World");
+    s.insert(5, "++");
+
+std::string keeps all characters in one array. Inserting or erasing in
+the middle moves every character after that point: O(n) per edit. For a
+100 MB document and millions of edits that is hours of memmove.
+
+A Rope stores the text as a sequence of PIECES. Each piece is a view
+(buffer, offset, length) into an immutable buffer. The pieces live in a
+balanced binary tree ordered by position, and every node remembers how
+many characters its subtree holds, so "where is character i" is one walk
+from the root: O(log pieces).
+
+  insert / erase / replace : split the tree at the edit positions and
+                             join the parts back together, O(log n)
+  substr                   : split out the range; the new Rope SHARES
+                             nodes and buffers with the old one, O(log n)
+  read                     : visit the pieces in order as string_views
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+using namespace std;
+
+// ============= ROPE =============
+
+/*
+The tree is an IMPLICIT TREAP: nodes are ordered by position (no keys are
+stored), and each node has a random priority; parents always have a
+higher priority than their children. Random priorities keep the expected
+depth at O(log n) without any rebalancing code. Everything is built from
+two operations:
+    split(t, pos)  -> (first pos characters, the rest)
+    merge(a, b)    -> a followed by b
+
+PERSISTENCE: nodes are never modified after creation. An edit creates new
+nodes only along the O(log n) paths it touches and shares everything
+else (via shared_ptr) with the previous version. That makes copies and
+substr() O(1) / O(log n), and old versions stay valid.
+
+SMALL EDITS: inserting a few characters right after a small piece copies
+that piece and the new text into one new buffer (at most LEAF_MAX bytes)
+instead of adding a tiny piece, so typing does not grow the tree by one
+node per keystroke.
+
+Thread safety: like std::string, one Rope must not be modified by two
+threads at once. Different Ropes that share nodes are fine (shared_ptr
+reference counts are atomic, the nodes themselves are immutable, and the
+priority generator is per thread).
+*/
+class Rope {
+    private:
+        static constexpr size_t LEAF_MAX = 256;
+
+        struct Node;
+        using NodePtr = shared_ptr<const Node>;
+
+        struct Node {
+            shared_ptr<const string> buffer;  // Immutable characters
+            size_t offset;                    // This piece: buffer[offset, offset + length)
+            size_t length;
+            size_t total;                     // Characters in the whole subtree
+            uint32_t priority;
+            NodePtr left, right;
+
+            Node(shared_ptr<const string> b, size_t off, size_t len, uint32_t prio, NodePtr l, NodePtr r)
+                : buffer(move(b)), offset(off), length(len),
+                  total(len + (l ? l->total : 0) + (r ? r->total : 0)),
+                  priority(prio), left(move(l)), right(move(r)) {}
+
+            string_view piece() const {
+                return string_view(buffer->data() + offset, length);
+            }
+        };
+
+        NodePtr root;
+
+        // thread_local: Ropes edited on different threads never share the
+        // generator (priorities only need to look random, not be unique)
+        static uint32_t randomPriority() {
+            static thread_local uint32_t state = 2463534242u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        static size_t sizeOf(const NodePtr &t) {
+            return t ? t->total : 0;
+        }
+
+        // Same piece and priority as t, new children
+        static NodePtr withChildren(const NodePtr &t, NodePtr l, NodePtr r) {
+            return make_shared<const Node>(t->buffer, t->offset, t->length, t->priority, move(l), move(r));
+        }
+
+        static NodePtr leaf(shared_ptr<const string> buffer, size_t offset, size_t length) {
+            if (length == 0) return nullptr;
+            return make_shared<const Node>(move(buffer), offset, length, randomPriority(), nullptr, nullptr);
+        }
+
+        static NodePtr merge(const NodePtr &a, const NodePtr &b) {
+            if (!a) return b;
+            if (!b) return a;
+            if (a->priority > b->priority) return withChildren(a, a->left, merge(a->right, b));
+            return withChildren(b, merge(a, b->left), b->right);
+        }
+
+        static pair<NodePtr, NodePtr> split(const NodePtr &t, size_t pos) {
+            if (!t) return {nullptr, nullptr};
+            size_t leftSize = sizeOf(t->left);
+            if (pos <= leftSize) {
+                auto [a, b] = split(t->left, pos);
+                return {a, withChildren(t, b, t->right)};
+            }
+            if (pos >= leftSize + t->length) {
+                auto [a, b] = split(t->right, pos - leftSize - t->length);
+                return {withChildren(t, t->left, a), b};
+            }
+            // The cut falls inside this piece: two views of the same buffer.
+            // Each half gets a fresh priority; reusing t's for both would leave
+            // many equal priorities behind and the tree would lose its balance.
+            size_t k = pos - leftSize;
+            return {merge(t->left, leaf(t->buffer, t->offset, k)),
+                    merge(leaf(t->buffer, t->offset + k, t->length - k), t->right)};
+        }
+
+        static size_t depthOf(const Node *t) {
+            return t ? 1 + max(depthOf(t->left.get()), depthOf(t->right.get())) : 0;
+        }
+
+        static const Node* lastNode(const Node *t) {
+            while (t && t->right) t = t->right.get();
+            return t;
+        }
+
+        // left followed by a copy of text
+        static NodePtr appendText(const NodePtr &left, string_view text) {
+            if (text.empty()) return left;
+            const Node *last = lastNode(left.get());
+            if (last && last->length + text.size() <= LEAF_MAX) {
+                // Small edit: replace the last piece by (last piece + text)
+                auto [keep, old] = split(left, left->total - last->length);
+                string joined(old->piece());
+                joined.append(text);
+                size_t length = joined.size();
+                return merge(keep, leaf(make_shared<const string>(move(joined)), 0, length));
+            }
+            return merge(left, leaf(make_shared<const string>(text), 0, text.size()));
+        }
+
+        explicit Rope(NodePtr r) : root(move(r)) {}
+
+    public:
+        Rope() = default;
+
+        Rope(string_view text) {
+            if (!text.empty()) root = leaf(make_shared<const string>(text), 0, text.size());
+        }
+
+        size_t size() const {
+            return sizeOf(root);
+        }
+
+        bool empty() const {
+            return !root;
+        }
+
+        char operator[](size_t i) const {
+            const Node *t = root.get();
+            while (true) {
+                size_t leftSize = sizeOf(t->left);
+                if (i < leftSize) {
+                    t = t->left.get();
+                } else if (i < leftSize + t->length) {
+                    return (*t->buffer)[t->offset + i - leftSize];
+                } else {
+                    i -= leftSize + t->length;
+                    t = t->right.get();
+                }
+            }
+        }
+
+        char at(size_t i) const {
+            if (i >= size()) throw out_of_range("Rope::at");
+            return (*this)[i];
+        }
+
+        Rope& insert(size_t pos, string_view text) {
+            if (pos > size()) throw out_of_range("Rope::insert");
+            if (text.empty()) return *this;
+            auto [left, right] = split(root, pos);
+            root = merge(appendText(left, text), right);
+            return *this;
+        }
+
+        Rope& erase(size_t pos, size_t count = string::npos) {
+            if (pos > size()) throw out_of_range("Rope::erase");
+            count = min(count, size() - pos);
+            auto [left, rest] = split(root, pos);
+            auto [removed, right] = split(rest, count);
+            root = merge(left, right);
+            return *this;
+        }
+
+        // One pair of splits for erase + insert
+        Rope& replace(size_t pos, size_t count, string_view text) {
+            if (pos > size()) throw out_of_range("Rope::replace");
+            count = min(count, size() - pos);
+            auto [left, rest] = split(root, pos);
+            auto [removed, right] = split(rest, count);
+            root = merge(appendText(left, text), right);
+            return *this;
+        }
+
+        Rope& append(string_view text) {
+            return insert(size(), text);
+        }
+
+        // Shares nodes and buffers with *this: no characters are copied
+        Rope substr(size_t pos, size_t count = string::npos) const {
+            if (pos > size()) throw out_of_range("Rope::substr");
+            count = min(count, size() - pos);
+            auto [left, rest] = split(root, pos);
+            auto [middle, right] = split(rest, count);
+            return Rope(middle);
+        }
+
+        // Visits the text in order, one piece at a time
+        template <typename Func>
+        void forEachChunk(Func func) const {
+            vector<const Node*> stack;
+            const Node *t = root.get();
+            while (t || !stack.empty()) {
+                while (t) {
+                    stack.push_back(t);
+                    t = t->left.get();
+                }
+                t = stack.back();
+                stack.pop_back();
+                func(t->piece());
+                t = t->right.get();
+            }
+        }
+
+        string flatten() const {
+            string out;
+            out.reserve(size());
+            forEachChunk([&](string_view chunk) { out.append(chunk); });
+            return out;
+        }
+
+        size_t depth() const {
+            return depthOf(root.get());
+        }
+
+        size_t pieces() const {
+            size_t count = 0;
+            forEachChunk([&](string_view) { count++; });
+            return count;
+        }
+
+        // Range over the pieces: for (string_view chunk : rope.chunks()) { ... }
+        class ChunkIterator {
+            private:
+                vector<const Node*> stack;  // Path to the current node; empty = end()
+
+                void pushLeft(const Node *t) {
+                    for (; t; t = t->left.get()) stack.push_back(t);
+                }
+
+            public:
+                using iterator_category = forward_iterator_tag;
+                using value_type = string_view;
+                using difference_type = ptrdiff_t;
+                using pointer = const string_view*;
+                using reference = string_view;
+
+                ChunkIterator() = default;
+
+                explicit ChunkIterator(const Node *root) {
+                    pushLeft(root);
+                }
+
+                string_view operator*() const {
+                    return stack.back()->piece();
+                }
+
+                ChunkIterator& operator++() {
+                    const Node *t = stack.back();
+                    stack.pop_back();
+                    pushLeft(t->right.get());
+                    return *this;
+                }
+
+                bool operator==(const ChunkIterator &o) const {
+                    if (stack.empty() || o.stack.empty()) return stack.empty() == o.stack.empty();
+                    return stack.back() == o.stack.back();
+                }
+                bool operator!=(const ChunkIterator &o) const {
+                    return !(*this == o);
+                }
+        };
+
+        struct ChunkRange {
+            const Node *root;
+
+            ChunkIterator begin() const {
+                return ChunkIterator(root);
+            }
+            ChunkIterator end() const {
+                return ChunkIterator();
+            }
+        };
+
+        ChunkRange chunks() const {
+            return ChunkRange{root.get()};
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+string makeText(size_t n) {
+    string s(n, ' ');
+    unsigned seed = 42;
+    for (char &c : s) {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>('a' + (seed >> 16) % 26);
+    }
+    return s;
+}
+
+struct Edit {
+    enum Kind { Insert, Erase, Replace } kind;
+    size_t pos;
+    size_t count;
+    string text;
+};
+
+// Random edits at random positions; positions are valid for the document
+// size at the time each edit is applied
+vector<Edit> makeEdits(size_t docSize, size_t count) {
+    vector<Edit> edits;
+    uint64_t x = 88172645463325252ull;
+    auto rnd = [&] {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    };
+    size_t size = docSize;
+    for (size_t i = 0; i < count; i++) {
+        Edit e;
+        e.kind = static_cast<Edit::Kind>(rnd() % 3);
+        e.pos = size ? rnd() % size : 0;
+        e.count = e.kind == Edit::Insert ? 0 : min<size_t>(1 + rnd() % 16, size - e.pos);
+        if (e.kind != Edit::Erase) e.text = string(1 + rnd() % 16, static_cast<char>('A' + rnd() % 26));
+        size = size - e.count + e.text.size();
+        edits.push_back(move(e));
+    }
+    return edits;
+}
+
+template <typename Text>
+void applyEdits(Text &doc, const vector<Edit> &edits) {
+    for (const Edit &e : edits) {
+        switch (e.kind) {
+            case Edit::Insert: doc.insert(e.pos, e.text); break;
+            case Edit::Erase: doc.erase(e.pos, e.count); break;
+            case Edit::Replace: doc.replace(e.pos, e.count, e.text); break;
+        }
+    }
+}
+
+void benchmarkEdits(size_t docSize, size_t editCount) {
+    string original = makeText(docSize);
+    vector<Edit> edits = makeEdits(docSize, editCount);
+
+    string s = original;
+    double tString = timeMs([&] { applyEdits(s, edits); });
+    Rope r(original);
+    double tRope = timeMs([&] { applyEdits(r, edits); });
+
+    cout << docSize / (1024 * 1024) << " MB document, " << editCount << " random edits"
+         << (r.flatten() == s ? "" : "  (RESULTS DIFFER)") << "\n";
+    cout << "  std::string : " << tString << " ms (" << tString * 1e6 / double(editCount) << " ns/edit)\n";
+    cout << "  Rope        : " << tRope << " ms (" << tRope * 1e6 / double(editCount) << " ns/edit, "
+         << r.pieces() << " pieces)\n";
+}
+
+// One character at a time at a moving cursor in the middle of the document
+void benchmarkTyping(size_t docSize, size_t keystrokes) {
+    string original = makeText(docSize);
+    string s = original;
+    Rope r(original);
+    size_t cursor = docSize / 2;
+    double tString = timeMs([&] {
+        for (size_t i = 0; i < keystrokes; i++) s.insert(cursor + i, 1, static_cast<char>('a' + i % 26));
+    });
+    double tRope = timeMs([&] {
+        char c[1];
+        for (size_t i = 0; i < keystrokes; i++) {
+            c[0] = static_cast<char>('a' + i % 26);
+            r.insert(cursor + i, string_view(c, 1));
+        }
+    });
+    cout << "Typing " << keystrokes << " chars into the middle" << (r.flatten() == s ? "" : "  (RESULTS DIFFER)") << "\n";
+    cout << "  std::string : " << tString << " ms\n";
+    cout << "  Rope        : " << tRope << " ms (" << r.pieces() << " pieces)\n";
+}
+
+void benchmarkSubstr(size_t docSize, size_t count) {
+    string s = makeText(docSize);
+    Rope r(s);
+    r.insert(docSize / 3, "edit").erase(docSize / 2, 10);  // A few pieces, not just one
+    s.insert(docSize / 3, "edit").erase(docSize / 2, 10);
+    size_t len = s.size() / 4, checksum1 = 0, checksum2 = 0;
+    if (len == 0) {
+        cout << "document too small for the substr benchmark\n";
+        return;
+    }
+    // Start positions wrap so every substring lies inside the document
+    size_t starts = s.size() - len + 1;
+    double tString = timeMs([&] {
+        for (size_t i = 0; i < count; i++) checksum1 += s.substr(i * 1000 % starts, len)[len / 2];
+    });
+    double tRope = timeMs([&] {
+        for (size_t i = 0; i < count; i++) checksum2 += static_cast<size_t>(r.substr(i * 1000 % starts, len)[len / 2]);
+    });
+    cout << count << " substrings of " << len / 1024 << " KB" << (checksum1 == checksum2 ? "" : "  (RESULTS DIFFER)") << "\n";
+    cout << "  std::string : " << tString << " ms\n";
+    cout << "  Rope        : " << tRope << " ms\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  ROPE (PIECE-TREE STRING)\n";
+    cout << "========================================\n";
+
+    // ===== SAME EDITS AS main.cpp strings() =====
+    cout << "\n--- Rope edits ---\n";
+    Rope s("Hello");
+    s.append(" World");
+    cout << s.size() << "\n";
+    cout << s[0] << "\n";
+    cout << s.substr(0, 6).flatten() << "\n";
+    s.erase(6, s.size());
+    s.replace(0, 1, "T");
+    s.replace(0, 5, "World");
+    s.insert(5, "++");
+    cout << s.flatten() << "\n";
+
+    // ===== CHUNKS =====
+    cout << "\n--- chunks() ---\n";
+    Rope doc("The quick brown fox");
+    doc.insert(10, "red ").erase(4, 6);
+    for (string_view chunk : doc.chunks()) cout << "[" << chunk << "] ";
+    cout << "\n";
+
+    // ===== BENCHMARK =====
+    // ./rope <document MB> <edits compared with std::string> <Rope-only edits>
+    size_t mb = argc > 1 ? strtoull(argv[1], nullptr, 10) : 8;
+    size_t edits = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5000;
+    size_t ropeEdits = argc > 3 ? strtoull(argv[3], nullptr, 10) : 200000;
+    cout << "\n--- BENCHMARK ---\n";
+    benchmarkEdits(mb << 20, edits);
+    benchmarkTyping(mb << 20, edits);
+    benchmarkSubstr(mb << 20, 1000);
+
+    cout << "\n--- BENCHMARK: Rope only, " << ropeEdits << " edits ---\n";
+    Rope big(makeText(mb << 20));
+    vector<Edit> many = makeEdits(mb << 20, ropeEdits);
+    double t = timeMs([&] { applyEdits(big, many); });
+    cout << "  " << t << " ms (" << t * 1e6 / double(many.size()) << " ns/edit, " << big.pieces() << " pieces, depth " << big.depth() << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. PIECES INSTEAD OF ONE ARRAY:
+   - The text is a list of views into immutable buffers
+   - Edits change the list, never the characters
+
+2. IMPLICIT TREAP:
+   - Balanced tree ordered by position, subtree sizes in every node
+   - split + merge implement insert, erase, replace and substr
+   - Random priorities give O(log n) expected depth
+
+3. PERSISTENCE:
+   - Nodes are immutable; edits copy only the touched paths
+   - substr() and copies share nodes and buffers with the original
+
+4. SMALL EDITS:
+   - Tiny inserts are merged into the previous small piece
+   - Keeps the tree from growing by one node per keystroke
+
+5. READING:
+   - chunks() / forEachChunk() give string_views, no copying
+   - flatten() builds a std::string once, when you need one
+
+6. WHEN TO USE:
+   - Many edits in the middle of big text: Rope
+   - Small strings, mostly reading: std::string
+
+COMPILATION:
+    g++ -std=c++17 -O2 15_Rope.cpp -o rope && ./rope
+    ./rope 64 20000 5000000   (64 MB document, 20000 edits vs std::string, 5M Rope edits)
+
+NEXT STEP: Read input faster than cin!
+*/
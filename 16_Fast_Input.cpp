@@ -0,0 +1,495 @@
+/*
+=============================================================
+     FAST INPUT - PERFORMANCE TUTORIAL
+     File: 16_Fast_Input.cpp
+=============================================================
+Learn: block reads, mmap, hand-written integer parsing, from_chars,
+       why cin is slow
+
+main.cpp reads input like this:
+
+    for(int i = 0; i < 5; cin >> arr2[i], i++);
+
+    int n;
+    cin >> n;
+    getline(cin, name);
+
+Why cin >> is slow for tens of millions of numbers:
+  - By default cin is synchronized with C stdio, so it reads (nearly) one
+    character at a time through the C library
+  - Every >> builds a sentry object, checks stream state and goes through
+    the locale's num_get facet (thousands separators, etc.)
+  - scanf skips the C++ parts but still parses a format string per call
+
+FastReader instead:
+  - reads the input in 1 MB blocks with fread, or maps a file with mmap
+  - finds each token by scanning for whitespace in that block
+  - parses integers with a simple digit loop and floats with from_chars
+    (no locale, no allocation, no virtual calls)
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FASTIN_HAVE_MMAP 1
+#endif
+using namespace std;
+
+// ============= NUMBER PARSING =============
+
+/*
+Integers: one multiply-add per digit. Tokens with more digits than the
+type can always hold (e.g. > 9 for int) go through from_chars, which
+detects overflow; shorter ones cannot overflow.
+Floats: from_chars is the fastest correct parser in the standard library
+(C++17, GCC 11+). It is exact and ignores the locale, unlike strtod.
+Both return false if the token is not a complete number.
+*/
+template <typename T>
+bool parseNumber(string_view token, T &out) {
+    const char *p = token.data();
+    const char *end = p + token.size();
+    if constexpr (is_integral_v<T>) {
+        if (token.empty() || token.size() > size_t(numeric_limits<T>::digits10)) {
+            auto [ptr, ec] = from_chars(p + (p < end && *p == '+'), end, out);
+            return ec == errc() && ptr == end && !token.empty();
+        }
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            if constexpr (is_signed_v<T>) negative = *p == '-';
+            else if (*p == '-') return false;
+            if (++p == end) return false;
+        }
+        make_unsigned_t<T> value = 0;
+        for (; p < end; p++) {
+            unsigned digit = static_cast<unsigned char>(*p) - unsigned('0');
+            if (digit > 9) return false;
+            value = static_cast<make_unsigned_t<T>>(value * 10 + digit);
+        }
+        out = negative ? static_cast<T>(0 - value) : static_cast<T>(value);
+        return true;
+    } else {
+        if (p < end && *p == '+') p++;  // from_chars does not accept a leading '+'
+        auto [ptr, ec] = from_chars(p, end, out);
+        return ec == errc() && ptr == end && p != end;
+    }
+}
+
+// ============= FAST READER =============
+
+enum class ReadMode { Auto, Mmap, Buffered };
+
+/*
+Reads from stdin (default), any FILE*, a file opened with open(), or a
+string in memory.
+
+The unread input is always the range [pos, end). In buffered mode, when
+a token or line reaches the end of the block, the unread tail is moved
+to the front of the buffer and the rest is filled with the next block, so
+every token is contiguous in memory. A line longer than the buffer makes
+the buffer double. In mmap or memory mode the whole input is already in
+[pos, end).
+
+Semantics follow cin: read() skips whitespace (any byte <= ' ') first;
+readLine() returns the rest of the current line, so after read(n) the
+next readLine() returns what is left of n's line (often "").
+
+string_view results point into the buffer and are valid until the next
+call on the reader.
+*/
+class FastReader {
+    private:
+        FILE *file = nullptr;
+        bool ownsFile = false;
+        vector<char> buffer;
+        const char *pos = nullptr;
+        const char *end = nullptr;
+        bool eof = false;
+#ifdef FASTIN_HAVE_MMAP
+        void *mapped = nullptr;
+        size_t mappedSize = 0;
+#endif
+
+        static bool isSpace(char c) {
+            return static_cast<unsigned char>(c) <= ' ';
+        }
+
+        // Keeps [pos, end), appends the next block. false if nothing was added.
+        bool refill() {
+            if (eof) return false;
+            size_t keep = static_cast<size_t>(end - pos);
+            if (keep) memmove(buffer.data(), pos, keep);  // Before any resize: pos points into buffer
+            if (keep == buffer.size()) buffer.resize(buffer.size() * 2);  // Token longer than the buffer
+            size_t got = fread(buffer.data() + keep, 1, buffer.size() - keep, file);
+            pos = buffer.data();
+            end = pos + keep + got;
+            if (got == 0) {
+                eof = true;
+                return false;
+            }
+            return true;
+        }
+
+        bool skipSpace() {
+            while (true) {
+                while (pos < end && isSpace(*pos)) pos++;
+                if (pos < end) return true;
+                if (!refill()) return false;
+            }
+        }
+
+        void reset() {
+            if (ownsFile && file) fclose(file);
+#ifdef FASTIN_HAVE_MMAP
+            if (mapped) munmap(mapped, mappedSize);
+            mapped = nullptr;
+            mappedSize = 0;
+#endif
+            file = nullptr;
+            ownsFile = false;
+            pos = end = nullptr;
+            eof = true;
+        }
+
+    public:
+        explicit FastReader(FILE *f = stdin, size_t bufferBytes = 1 << 20)
+            : file(f), buffer(max<size_t>(bufferBytes, 64)), eof(f == nullptr) {}
+
+        FastReader(const FastReader&) = delete;
+        FastReader& operator=(const FastReader&) = delete;
+
+        ~FastReader() {
+            reset();
+        }
+
+        // Mmap (or Auto on POSIX): map the whole file. Buffered: fread blocks.
+        bool open(const string &path, ReadMode mode = ReadMode::Auto) {
+            reset();
+#ifdef FASTIN_HAVE_MMAP
+            if (mode != ReadMode::Buffered) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) return false;
+                struct stat st;
+                bool mappedOk = false;
+                if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                    size_t size = static_cast<size_t>(st.st_size);
+                    if (size == 0) {
+                        mappedOk = true;  // Empty file: nothing to map, already at EOF
+                    } else {
+                        void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (p != MAP_FAILED) {
+                            madvise(p, size, MADV_SEQUENTIAL);
+                            mapped = p;
+                            mappedSize = size;
+                            pos = static_cast<const char*>(p);
+                            end = pos + size;
+                            mappedOk = true;
+                        }
+                    }
+                }
+                ::close(fd);
+                if (mappedOk || mode == ReadMode::Mmap) return mappedOk;
+            }
+#else
+            if (mode == ReadMode::Mmap) return false;
+#endif
+            file = fopen(path.c_str(), "rb");
+            if (!file) return false;
+            ownsFile = true;
+            eof = false;
+            return true;
+        }
+
+        // Parse text that is already in memory. It must outlive the reader's use.
+        void assign(string_view text) {
+            reset();
+            pos = text.data();
+            end = pos + text.size();
+        }
+
+        // Next whitespace-separated token, or false at end of input
+        bool readToken(string_view &token) {
+            if (!skipSpace()) return false;
+            const char *p = pos;
+            while (true) {
+                while (p < end && !isSpace(*p)) p++;
+                if (p < end || eof) break;
+                size_t scanned = static_cast<size_t>(p - pos);
+                bool more = refill();  // Moves the token to the front of the buffer
+                p = pos + scanned;
+                if (!more) break;
+            }
+            token = string_view(pos, static_cast<size_t>(p - pos));
+            pos = p;
+            return true;
+        }
+
+        // int, long long, unsigned, double, float, char, string, string_view.
+        // Returns false at end of input or if the token is not a valid T
+        // (the token is consumed either way).
+        template <typename T>
+        bool read(T &out) {
+            if constexpr (is_same_v<T, char>) {
+                if (!skipSpace()) return false;
+                out = *pos++;
+                return true;
+            } else {
+                string_view token;
+                if (!readToken(token)) return false;
+                if constexpr (is_same_v<T, string_view>) {
+                    out = token;
+                    return true;
+                } else if constexpr (is_same_v<T, string>) {
+                    out.assign(token);
+                    return true;
+                } else {
+                    static_assert(is_arithmetic_v<T>, "read<T>: unsupported type");
+                    return parseNumber(token, out);
+                }
+            }
+        }
+
+        // T value = in.read<T>();  (T{} at end of input)
+        template <typename T>
+        T read() {
+            T value{};
+            read(value);
+            return value;
+        }
+
+        // Appends up to n values to out; returns how many were read
+        template <typename T>
+        size_t read_n(vector<T> &out, size_t n) {
+            out.reserve(out.size() + n);
+            size_t count = 0;
+            T value;
+            while (count < n && read(value)) {
+                out.push_back(value);
+                count++;
+            }
+            return count;
+        }
+
+        // Rest of the current line without '\n' (and '\r'); false at end of input
+        bool readLine(string_view &line) {
+            if (pos == end && !refill()) return false;
+            size_t scanned = 0;
+            while (true) {
+                const void *nl = memchr(pos + scanned, '\n', static_cast<size_t>(end - pos) - scanned);
+                if (nl) {
+                    const char *lineEnd = static_cast<const char*>(nl);
+                    line = string_view(pos, static_cast<size_t>(lineEnd - pos));
+                    pos = lineEnd + 1;
+                    break;
+                }
+                scanned = static_cast<size_t>(end - pos);
+                if (!refill()) {  // Last line without a trailing '\n'
+                    line = string_view(pos, static_cast<size_t>(end - pos));
+                    pos = end;
+                    break;
+                }
+            }
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            return true;
+        }
+
+        bool readLine(string &line) {
+            string_view view;
+            if (!readLine(view)) return false;
+            line.assign(view);
+            return true;
+        }
+
+        bool atEnd() {
+            return !skipSpace();
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// count integers, 10 per line, followed by count / 10 floats
+void writeTestFile(const string &path, size_t count) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) return;
+    unsigned seed = 7;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        fprintf(f, "%d%c", static_cast<int>(seed >> 1) - (1 << 30), i % 10 == 9 ? '\n' : ' ');
+    }
+    for (size_t i = 0; i < count / 10; i++) {
+        seed = seed * 1103515245u + 12345u;
+        fprintf(f, "%.6f\n", double(seed % 2000000) / 1000.0 - 1000.0);
+    }
+    fclose(f);
+}
+
+struct Totals {
+    long long ints = 0;
+    double floats = 0;
+
+    bool operator==(const Totals &o) const {
+        return ints == o.ints && floats - o.floats < 1e-3 && o.floats - floats < 1e-3;
+    }
+};
+
+void benchmark(size_t count) {
+    const string path = "fast_input_bench.tmp";
+    writeTestFile(path, count);
+    size_t floats = count / 10;
+    Totals cinTotals, scanfTotals, ifsTotals, bufTotals, mmapTotals;
+
+    // cin as in main.cpp: synchronized with stdio (the default)
+    double tCin = timeMs([&] {
+        if (!freopen(path.c_str(), "rb", stdin)) return;
+        cin.clear();
+        int x;
+        double d;
+        for (size_t i = 0; i < count && cin >> x; i++) cinTotals.ints += x;
+        for (size_t i = 0; i < floats && cin >> d; i++) cinTotals.floats += d;
+    });
+
+    double tScanf = timeMs([&] {
+        if (!freopen(path.c_str(), "rb", stdin)) return;
+        int x;
+        double d;
+        for (size_t i = 0; i < count && scanf("%d", &x) == 1; i++) scanfTotals.ints += x;
+        for (size_t i = 0; i < floats && scanf("%lf", &d) == 1; i++) scanfTotals.floats += d;
+    });
+
+    // Unsynchronized iostream (ifstream is never tied to stdio)
+    double tIfs = timeMs([&] {
+        ifstream in(path);
+        int x;
+        double d;
+        for (size_t i = 0; i < count && in >> x; i++) ifsTotals.ints += x;
+        for (size_t i = 0; i < floats && in >> d; i++) ifsTotals.floats += d;
+    });
+
+    auto fast = [&](ReadMode mode, Totals &totals) {
+        return timeMs([&] {
+            FastReader in;
+            if (!in.open(path, mode)) return;
+            vector<int> values;
+            in.read_n(values, count);
+            for (int v : values) totals.ints += v;
+            double d;
+            for (size_t i = 0; i < floats && in.read(d); i++) totals.floats += d;
+        });
+    };
+    double tBuffered = fast(ReadMode::Buffered, bufTotals);
+    double tMmap = fast(ReadMode::Mmap, mmapTotals);
+
+    FILE *f = fopen(path.c_str(), "rb");
+    fseek(f, 0, SEEK_END);
+    double mb = double(ftell(f)) / (1024.0 * 1024.0);
+    fclose(f);
+    remove(path.c_str());
+
+    bool ok = scanfTotals == cinTotals && ifsTotals == cinTotals && bufTotals == cinTotals &&
+              (mmapTotals == cinTotals || mmapTotals == Totals());
+    cout << count << " ints + " << floats << " floats (" << mb << " MB)" << (ok ? "" : "  (RESULTS DIFFER)") << "\n";
+    cout << "  cin >> (synced)     : " << tCin << " ms (" << mb / tCin * 1000 << " MB/s)\n";
+    cout << "  scanf               : " << tScanf << " ms (" << mb / tScanf * 1000 << " MB/s)\n";
+    cout << "  ifstream >>         : " << tIfs << " ms (" << mb / tIfs * 1000 << " MB/s)\n";
+    cout << "  FastReader (fread)  : " << tBuffered << " ms (" << mb / tBuffered * 1000 << " MB/s)\n";
+    if (mmapTotals.ints) cout << "  FastReader (mmap)   : " << tMmap << " ms (" << mb / tMmap * 1000 << " MB/s)\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  FAST INPUT\n";
+    cout << "========================================\n";
+
+    // ===== SAME INPUT AS main.cpp =====
+    // FastReader in; would read stdin; here the input comes from a string
+    cout << "\n--- read<T>, read_n, readLine ---\n";
+    FastReader in;
+    in.assign("5\n10 20 30 40 50\n42\nNithwin Kumar\n3.14 -2.5e3\n");
+
+    int n = in.read<int>();
+    vector<int> arr2;
+    in.read_n(arr2, static_cast<size_t>(n));
+    for (int v : arr2) cout << v << " ";
+    cout << "\n";
+
+    int x;
+    in.read(x);
+    string name;
+    in.readLine(name);  // Rest of "42"'s line: empty, like getline after cin >>
+    in.readLine(name);
+    cout << x << ", " << name << "\n";
+
+    double a = in.read<double>(), b = in.read<double>();
+    cout << a << " " << b << " (end of input: " << boolalpha << in.atEnd() << ")\n";
+
+    // ===== BENCHMARK =====
+    // Number of integers: ./fastin 50000000
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    cout << "\n--- BENCHMARK ---\n";
+    benchmark(count);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. WHY CIN IS SLOW:
+   - Synchronized with stdio by default (tiny reads)
+   - Sentry + locale-aware num_get on every >>
+   - ios::sync_with_stdio(false) and cin.tie(nullptr) help, but the
+     per-value overhead stays
+
+2. BLOCK READS:
+   - fread 1 MB at a time into one reusable buffer
+   - Move the unfinished token to the front before the next block
+   - mmap: the whole file is already in memory, no copies at all
+
+3. PARSING:
+   - Integers: digit loop, from_chars only when overflow is possible
+   - Floats: from_chars (exact, no locale, no allocation)
+
+4. API:
+   - read<T>() / read(T&) for one value
+   - read_n(vector, n) for bulk reads into a vector
+   - readLine() returns a string_view into the buffer
+
+5. LIFETIMES:
+   - string_view results are valid until the next call on the reader
+   - Copy into a string if you need to keep them
+
+COMPILATION:
+    g++ -std=c++17 -O2 16_Fast_Input.cpp -o fastin && ./fastin
+    ./fastin 50000000   (50M integers)
+
+NEXT STEP: Write output faster than cout << endl!
+*/
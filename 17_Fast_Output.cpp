@@ -0,0 +1,394 @@
+/*
+=============================================================
+     FAST OUTPUT - PERFORMANCE TUTORIAL
+     File: 17_Fast_Output.cpp
+=============================================================
+Learn: output buffering, endl vs '\n', to_chars, write/writev syscalls
+
+Every tutorial file (01_Basics.cpp, 02_Functions.cpp, main11.cpp, ...)
+prints like this:
+
+    cout << "Name: " << name << endl;
+
+endl is '\n' PLUS a flush. A flush hands the buffered bytes to the
+operating system with a write() system call, so printing 10 million lines
+with endl means 10 million system calls - the program spends its time in
+the kernel, not in our code.
+
+Steps to fast output:
+  1. '\n' instead of endl: the stream flushes only when its buffer fills
+  2. Format numbers without the locale machinery of operator<<: to_chars
+     writes the digits straight into a char buffer
+  3. One big user-space buffer (64 KB+) that is flushed when full or when
+     asked, so a syscall moves tens of thousands of lines at once
+  4. writev: hand several separate buffers (e.g. our buffer plus a big
+     string the caller owns) to the kernel in ONE call, without copying
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <cstdint>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define FASTOUT_HAVE_POSIX 1
+#endif
+using namespace std;
+
+// ============= FAST WRITER =============
+
+/*
+FastWriter owns one buffer. Every write appends to it; when there is not
+enough room left, the buffer is flushed first. Nothing reaches the file
+until the buffer is full, flush() is called, or the writer is destroyed.
+
+On POSIX the bytes go out with write()/writev() on the file descriptor of
+the FILE* (the FILE's own buffer is flushed once, at construction). Other
+systems use fwrite on the FILE*.
+
+Mixing with printf/cout on the same file: call flush() before switching,
+or the output comes out of order (same rule as mixing stdio and cout with
+sync_with_stdio(false)).
+*/
+class FastWriter {
+    private:
+        FILE *file;
+        vector<char> buffer;
+        size_t used = 0;
+        size_t syscalls = 0;
+#ifdef FASTOUT_HAVE_POSIX
+        int fd;
+
+        // write() may write fewer bytes than asked (pipes, signals): loop
+        void writeAll(const char *p, size_t n) {
+            while (n > 0) {
+                ssize_t done = ::write(fd, p, n);
+                syscalls++;
+                if (done < 0) {
+                    if (errno == EINTR) continue;
+                    return;  // Output closed or disk full: drop the rest, like a failed stream
+                }
+                p += done;
+                n -= static_cast<size_t>(done);
+            }
+        }
+#else
+        void writeAll(const char *p, size_t n) {
+            fwrite(p, 1, n, file);
+            fflush(file);
+            syscalls++;
+        }
+#endif
+
+        // Makes sure at least n bytes are free
+        char* reserve(size_t n) {
+            if (buffer.size() - used < n) flush();
+            return buffer.data() + used;
+        }
+
+    public:
+        explicit FastWriter(FILE *f = stdout, size_t bufferBytes = 1 << 16)
+            : file(f), buffer(max<size_t>(bufferBytes, 128)) {
+            fflush(file);
+#ifdef FASTOUT_HAVE_POSIX
+            fd = fileno(file);
+#endif
+        }
+
+        FastWriter(const FastWriter&) = delete;
+        FastWriter& operator=(const FastWriter&) = delete;
+
+        ~FastWriter() {
+            flush();
+        }
+
+        void flush() {
+            if (used) writeAll(buffer.data(), used);
+            used = 0;
+        }
+
+        FastWriter& write(char c) {
+            *reserve(1) = c;
+            used++;
+            return *this;
+        }
+
+        // Big strings are not copied: they go out together with the buffer in one writev
+        FastWriter& write(string_view s) {
+            if (s.size() <= buffer.size() - used) {
+                memcpy(buffer.data() + used, s.data(), s.size());
+                used += s.size();
+            } else if (s.size() < buffer.size() / 2) {
+                flush();
+                memcpy(buffer.data(), s.data(), s.size());
+                used = s.size();
+            } else {
+                writeBatch(&s, 1);
+            }
+            return *this;
+        }
+
+        // Integers: to_chars writes the digits directly into the buffer
+        template <typename T, typename = enable_if_t<is_integral_v<T> && !is_same_v<T, bool> && !is_same_v<T, char>>>
+        FastWriter& write(T value) {
+            char *p = reserve(24);  // Longest 64-bit integer: 20 digits + sign
+            used = static_cast<size_t>(to_chars(p, buffer.data() + buffer.size(), value).ptr - buffer.data());
+            return *this;
+        }
+
+        // Shortest text that reads back as the same double (like printf("%.17g") but minimal)
+        FastWriter& write(double value) {
+            char *p = reserve(32);
+            used = static_cast<size_t>(to_chars(p, buffer.data() + buffer.size(), value).ptr - buffer.data());
+            return *this;
+        }
+
+        // Fixed notation with `precision` digits after the point, like printf("%.2f")
+        FastWriter& write(double value, int precision) {
+            char *p = reserve(static_cast<size_t>(max(precision, 0)) + 32);
+            auto result = to_chars(p, buffer.data() + buffer.size(), value, chars_format::fixed, precision);
+            if (result.ec != errc()) {  // Huge value: the digits do not fit, fall back to shortest form
+                return write(value);
+            }
+            used = static_cast<size_t>(result.ptr - buffer.data());
+            return *this;
+        }
+
+        FastWriter& write(bool value) {
+            return write(value ? '1' : '0');  // Same as cout without boolalpha
+        }
+
+        // Writes the buffer and all parts with as few system calls as possible.
+        // The parts are not copied; they only need to stay valid during the call.
+        void writeBatch(const string_view *parts, size_t count) {
+#ifdef FASTOUT_HAVE_POSIX
+            vector<iovec> iov;
+            iov.reserve(count + 1);
+            if (used) iov.push_back({buffer.data(), used});
+            for (size_t i = 0; i < count; i++) {
+                if (!parts[i].empty()) iov.push_back({const_cast<char*>(parts[i].data()), parts[i].size()});
+            }
+            used = 0;
+            size_t first = 0;
+            while (first < iov.size()) {
+                int batch = static_cast<int>(min<size_t>(iov.size() - first, IOV_MAX));
+                ssize_t done = ::writev(fd, iov.data() + first, batch);
+                syscalls++;
+                if (done < 0) {
+                    if (errno == EINTR) continue;
+                    return;
+                }
+                // Partial write: skip the finished entries, trim the next one
+                size_t left = static_cast<size_t>(done);
+                while (first < iov.size() && left >= iov[first].iov_len) left -= iov[first++].iov_len;
+                if (left) {
+                    iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                    iov[first].iov_len -= left;
+                }
+            }
+#else
+            flush();
+            for (size_t i = 0; i < count; i++) writeAll(parts[i].data(), parts[i].size());
+#endif
+        }
+
+        void writeBatch(const vector<string_view> &parts) {
+            writeBatch(parts.data(), parts.size());
+        }
+
+        // out << x << ' ' << y << '\n';
+        template <typename T>
+        FastWriter& operator<<(const T &value) {
+            if constexpr (is_convertible_v<const T&, string_view>) return write(string_view(value));
+            else return write(value);
+        }
+
+        size_t systemCalls() const {
+            return syscalls;
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+#ifdef FASTOUT_HAVE_POSIX
+
+// Runs body with stdout redirected to path; returns the time and file size
+pair<double, long long> timeToFile(const string &path, void (*body)(size_t), size_t count) {
+    cout.flush();
+    fflush(stdout);
+    int saved = dup(1);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    dup2(fd, 1);
+    ::close(fd);
+    double ms = timeMs([&] {
+        body(count);
+        cout.flush();
+        fflush(stdout);
+    });
+    dup2(saved, 1);
+    ::close(saved);
+    struct stat st;
+    long long bytes = stat(path.c_str(), &st) == 0 ? static_cast<long long>(st.st_size) : -1;
+    return {ms, bytes};
+}
+
+// Wraps in unsigned arithmetic and converts once: subtracting from an
+// int here could overflow, which is undefined behaviour
+int value(size_t i) {
+    return static_cast<int>(static_cast<uint32_t>(i * 2654435761u) - 1000000000u);
+}
+
+void printCoutEndl(size_t count) {
+    for (size_t i = 0; i < count; i++) cout << value(i) << endl;
+}
+
+void printCoutNewline(size_t count) {
+    for (size_t i = 0; i < count; i++) cout << value(i) << '\n';
+}
+
+void printPrintf(size_t count) {
+    for (size_t i = 0; i < count; i++) printf("%d\n", value(i));
+}
+
+void printFastWriter(size_t count) {
+    FastWriter out;
+    for (size_t i = 0; i < count; i++) out << value(i) << '\n';
+}
+
+// Lines formatted into one string block per 1000 lines, sent with writev
+void printWritevBatch(size_t count) {
+    FastWriter out;
+    vector<string> blocks(64);
+    vector<string_view> parts;
+    for (size_t i = 0; i < count;) {
+        parts.clear();
+        for (string &block : blocks) {
+            block.clear();
+            char num[16];
+            for (size_t k = 0; k < 1000 && i < count; k++, i++) {
+                block.append(num, static_cast<size_t>(to_chars(num, num + sizeof(num), value(i)).ptr - num));
+                block += '\n';
+            }
+            parts.push_back(block);
+            if (i == count) break;
+        }
+        out.writeBatch(parts);
+    }
+}
+
+void benchmark(size_t count) {
+    const string path = "fast_output_bench.tmp";
+    struct Run {
+        const char *name;
+        void (*body)(size_t);
+    };
+    Run runs[] = {
+        {"cout << endl        ", printCoutEndl},
+        {"cout << '\\n'        ", printCoutNewline},
+        {"printf              ", printPrintf},
+        {"FastWriter          ", printFastWriter},
+        {"FastWriter + writev ", printWritevBatch},
+    };
+    long long expected = -1;
+    cout << count << " integers, one per line\n";
+    for (const Run &run : runs) {
+        auto [ms, bytes] = timeToFile(path, run.body, count);
+        if (expected < 0) expected = bytes;
+        cout << "  " << run.name << ": " << ms << " ms (" << double(bytes) / (1024.0 * 1024.0) / ms * 1000 << " MB/s)"
+             << (bytes == expected ? "" : "  (SIZE DIFFERS)") << "\n";
+    }
+    remove(path.c_str());
+}
+
+#endif
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  FAST OUTPUT\n";
+    cout << "========================================\n";
+
+    // ===== SAME OUTPUT AS 01_Basics.cpp =====
+    cout << "\n--- FastWriter ---\n";
+    cout.flush();
+    {
+        FastWriter out;
+        string name = "John Doe";
+        out << "Name: " << name << '\n';
+        out << "Age: " << 25 << '\n';
+        out << "Price: " << 19.99 << '\n';
+        out.write(3.14159265359, 2) << '\n';  // Fixed, 2 decimals
+
+        vector<string_view> parts = {"writev: ", "several ", "buffers, ", "one call\n"};
+        out.writeBatch(parts);  // Sends the buffered lines above too
+    }  // Destructor flushes
+
+    // ===== BENCHMARK =====
+    // ./fastout 10000000
+#ifdef FASTOUT_HAVE_POSIX
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    cout << "\n--- BENCHMARK (output to a file) ---\n";
+    benchmark(count);
+#else
+    (void)argc;
+    (void)argv;
+    cout << "\n(benchmark needs POSIX dup2 to redirect stdout)\n";
+#endif
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ENDL FLUSHES:
+   - endl = '\n' + flush = one system call per line
+   - Use '\n'; flush only when output must appear now (prompts, logs
+     before a crash)
+
+2. BUFFERING:
+   - Collect output in a big user-space buffer
+   - One write() moves many KB at once
+
+3. FORMATTING:
+   - to_chars: no locale, no allocation, no format string
+   - Shortest round-trip form for doubles, or fixed with a precision
+
+4. WRITEV:
+   - Several buffers, one system call, no copying into our buffer
+   - Handle partial writes by advancing through the iovec array
+
+5. ORDERING:
+   - A writer has its own buffer: flush() before mixing with cout/printf
+
+COMPILATION:
+    g++ -std=c++17 -O2 17_Fast_Output.cpp -o fastout && ./fastout
+    ./fastout 50000000   (50M integers)
+
+NEXT STEP: Keep small vectors off the heap!
+*/
@@ -0,0 +1,554 @@
+/*
+=============================================================
+     SMALL VECTOR & STATIC VECTOR - PERFORMANCE TUTORIAL
+     File: 18_Small_Vector.cpp
+=============================================================
+Learn: inline (stack) storage, placement new, heap fallback,
+       allocation counting, tail latency
+
+arrays() in main.cpp sizes an array at runtime like this:
+
+    int n;
+    cin >> n;
+    int arr5[n];  // Variable length array
+    // int *arrVLA = new int[n];
+
+int arr5[n] is a VLA: a C99 feature that g++ accepts as an extension but
+standard C++ does not allow (and a big n silently overflows the stack).
+new int[n] / vector<int>(n) are standard but call malloc every time, even
+when n is 3 - and short-lived small buffers are extremely common.
+
+This file adds two standard-conforming containers:
+  small_vector<T, N>  : the first N elements live INSIDE the object (on
+                        the stack for a local variable); only when it
+                        grows beyond N does it move to the heap
+  static_vector<T, N> : capacity fixed at N, never allocates; pushing
+                        past N throws length_error
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= SMALL VECTOR =============
+
+/*
+Layout: pointer to the elements, size, capacity, and a raw byte array big
+enough for N elements. While data_ points at that array, no heap memory
+is used at all.
+
+Raw bytes (not T[N]) so that only the elements that exist are constructed:
+a small_vector<string, 16> with 2 elements has built 2 strings, not 16.
+Elements are created with placement new and destroyed by hand.
+
+Growing past N (or past a heap capacity) allocates double the capacity
+and moves the elements over. Like std::vector, elements are moved only
+if their move constructor is noexcept (otherwise copied), so a throwing
+move cannot lose data.
+
+Cost: moving a small_vector moves its elements one by one while they are
+inline (a std::vector move is just 3 pointers), and the object itself is
+bigger by N * sizeof(T).
+*/
+template <typename T, size_t N>
+class small_vector {
+    private:
+        T *data_;
+        size_t size_ = 0;
+        size_t capacity_ = N;
+        alignas(T) unsigned char inline_[N > 0 ? N * sizeof(T) : 1];
+
+        T* inlineData() {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        // Moves (or copies) n elements from src into raw memory at dst
+        static void relocate(T *src, size_t n, T *dst) {
+            if constexpr (is_nothrow_move_constructible_v<T> || !is_copy_constructible_v<T>) {
+                uninitialized_move(src, src + n, dst);
+            } else {
+                uninitialized_copy(src, src + n, dst);
+            }
+            destroy(src, src + n);
+        }
+
+        void releaseHeap() {
+            if (data_ != inlineData()) allocator<T>().deallocate(data_, capacity_);
+        }
+
+        void reallocate(size_t newCapacity) {
+            T *fresh = allocator<T>().allocate(newCapacity);
+            relocate(data_, size_, fresh);
+            releaseHeap();
+            data_ = fresh;
+            capacity_ = newCapacity;
+        }
+
+        size_t grownCapacity(size_t needed) const {
+            return max(needed, capacity_ * 2);
+        }
+
+        // *this must be empty and inline. Heap storage is stolen;
+        // inline elements have to be moved one by one.
+        void takeFrom(small_vector &other) {
+            if (other.data_ != other.inlineData()) {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inlineData();
+                other.capacity_ = N;
+                other.size_ = 0;
+            } else {
+                uninitialized_move(other.begin(), other.end(), data_);
+                size_ = other.size_;
+                other.clear();
+            }
+        }
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr size_t inline_capacity = N;
+
+        small_vector() : data_(inlineData()) {}
+
+        explicit small_vector(size_t count) : small_vector() {
+            resize(count);
+        }
+
+        small_vector(size_t count, const T &value) : small_vector() {
+            resize(count, value);
+        }
+
+        small_vector(initializer_list<T> items) : small_vector() {
+            reserve(items.size());
+            for (const T &item : items) push_back(item);
+        }
+
+        small_vector(const small_vector &other) : small_vector() {
+            reserve(other.size_);
+            uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+
+        small_vector(small_vector &&other) noexcept(is_nothrow_move_constructible_v<T>) : small_vector() {
+            takeFrom(other);
+        }
+
+        small_vector& operator=(const small_vector &other) {
+            if (this != &other) {
+                small_vector copy(other);
+                *this = move(copy);
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector &&other) noexcept(is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                releaseHeap();
+                data_ = inlineData();
+                capacity_ = N;
+                takeFrom(other);
+            }
+            return *this;
+        }
+
+        ~small_vector() {
+            clear();
+            releaseHeap();
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (size_ == capacity_) {
+                // Build the new element first: args may refer to an element of *this
+                size_t newCapacity = grownCapacity(size_ + 1);
+                T *fresh = allocator<T>().allocate(newCapacity);
+                try {
+                    new (fresh + size_) T(forward<Args>(args)...);
+                } catch (...) {
+                    allocator<T>().deallocate(fresh, newCapacity);
+                    throw;
+                }
+                relocate(data_, size_, fresh);
+                releaseHeap();
+                data_ = fresh;
+                capacity_ = newCapacity;
+            } else {
+                new (data_ + size_) T(forward<Args>(args)...);
+            }
+            return data_[size_++];
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(move(value));
+        }
+
+        void pop_back() {
+            data_[--size_].~T();
+        }
+
+        void reserve(size_t newCapacity) {
+            if (newCapacity > capacity_) reallocate(newCapacity);
+        }
+
+        void resize(size_t count) {
+            if (count > capacity_) reallocate(grownCapacity(count));
+            while (size_ < count) new (data_ + size_++) T();
+            while (size_ > count) pop_back();
+        }
+
+        void resize(size_t count, const T &value) {
+            if (count > capacity_) {
+                T copy(value);  // value may live in *this
+                reallocate(grownCapacity(count));
+                while (size_ < count) new (data_ + size_++) T(copy);
+            }
+            while (size_ < count) new (data_ + size_++) T(value);
+            while (size_ > count) pop_back();
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            T *from = data_ + (first - data_);
+            T *to = data_ + (last - data_);
+            T *newEnd = move(to, end(), from);
+            destroy(newEnd, end());
+            size_ -= static_cast<size_t>(to - from);
+            return from;
+        }
+
+        iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        void clear() {
+            destroy(begin(), end());
+            size_ = 0;
+        }
+
+        T& operator[](size_t i) { return data_[i]; }
+        const T& operator[](size_t i) const { return data_[i]; }
+
+        T& at(size_t i) {
+            if (i >= size_) throw out_of_range("small_vector::at");
+            return data_[i];
+        }
+        const T& at(size_t i) const {
+            if (i >= size_) throw out_of_range("small_vector::at");
+            return data_[i];
+        }
+
+        T& front() { return data_[0]; }
+        T& back() { return data_[size_ - 1]; }
+        const T& front() const { return data_[0]; }
+        const T& back() const { return data_[size_ - 1]; }
+
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        // true while no heap memory is in use
+        bool is_inline() const {
+            return data_ == reinterpret_cast<const T*>(inline_);
+        }
+};
+
+// ============= STATIC VECTOR =============
+
+/*
+Same inline storage, but no heap fallback: capacity is always N.
+The size can change at runtime (unlike array<T, N>), the memory never
+does. Good for buffers with a known upper bound, e.g. "at most 16
+neighbours" or "at most 64 tokens per line".
+*/
+template <typename T, size_t N>
+class static_vector {
+    private:
+        size_t size_ = 0;
+        alignas(T) unsigned char storage_[N > 0 ? N * sizeof(T) : 1];
+
+        T* ptr() { return reinterpret_cast<T*>(storage_); }
+        const T* ptr() const { return reinterpret_cast<const T*>(storage_); }
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static_vector() = default;
+
+        explicit static_vector(size_t count) {
+            resize(count);
+        }
+
+        static_vector(initializer_list<T> items) {
+            for (const T &item : items) push_back(item);
+        }
+
+        static_vector(const static_vector &other) {
+            uninitialized_copy(other.begin(), other.end(), ptr());
+            size_ = other.size_;
+        }
+
+        static_vector(static_vector &&other) noexcept(is_nothrow_move_constructible_v<T>) {
+            uninitialized_move(other.begin(), other.end(), ptr());
+            size_ = other.size_;
+            other.clear();
+        }
+
+        static_vector& operator=(const static_vector &other) {
+            if (this != &other) {
+                clear();
+                uninitialized_copy(other.begin(), other.end(), ptr());
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        static_vector& operator=(static_vector &&other) noexcept(is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                uninitialized_move(other.begin(), other.end(), ptr());
+                size_ = other.size_;
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~static_vector() {
+            clear();
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (size_ == N) throw length_error("static_vector: capacity exceeded");
+            new (ptr() + size_) T(forward<Args>(args)...);
+            return ptr()[size_++];
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(move(value));
+        }
+
+        void pop_back() {
+            ptr()[--size_].~T();
+        }
+
+        void resize(size_t count) {
+            if (count > N) throw length_error("static_vector: capacity exceeded");
+            while (size_ < count) new (ptr() + size_++) T();
+            while (size_ > count) pop_back();
+        }
+
+        void clear() {
+            destroy(begin(), end());
+            size_ = 0;
+        }
+
+        T& operator[](size_t i) { return ptr()[i]; }
+        const T& operator[](size_t i) const { return ptr()[i]; }
+
+        T& at(size_t i) {
+            if (i >= size_) throw out_of_range("static_vector::at");
+            return ptr()[i];
+        }
+
+        T& front() { return ptr()[0]; }
+        T& back() { return ptr()[size_ - 1]; }
+
+        T* data() { return ptr(); }
+        const T* data() const { return ptr(); }
+        iterator begin() { return ptr(); }
+        iterator end() { return ptr() + size_; }
+        const_iterator begin() const { return ptr(); }
+        const_iterator end() const { return ptr() + size_; }
+
+        size_t size() const { return size_; }
+        static constexpr size_t capacity() { return N; }
+        bool empty() const { return size_ == 0; }
+        bool full() const { return size_ == N; }
+};
+
+// ============= ALLOCATION COUNTING =============
+
+/*
+Replacing the global operator new lets the benchmark count every heap
+allocation made by the program (vector, string, small_vector fallback).
+*/
+struct AllocCounter {
+    static inline size_t allocations = 0;
+};
+
+void *operator new(size_t size) {
+    AllocCounter::allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+// ============= BENCHMARK =============
+
+using Clock = chrono::steady_clock;
+
+long long checksumSink = 0;  // printed at the end so the loops are not optimized away
+
+// Each operation builds a short-lived buffer of 1..maxLen values and reduces it.
+// Timed in batches of 1000 operations to get a latency distribution.
+template <typename Buffer>
+void benchmark(const char *name, size_t ops, size_t maxLen) {
+    uint32_t seed = 12345;
+    long long checksum = 0;
+    vector<double> batchNs;
+    batchNs.reserve(ops / 1000 + 1);
+    size_t allocsBefore = AllocCounter::allocations;
+
+    auto start = Clock::now();
+    for (size_t done = 0; done < ops; done += 1000) {
+        auto batchStart = Clock::now();
+        for (size_t k = 0; k < 1000; k++) {
+            seed = seed * 1664525u + 1013904223u;
+            size_t len = 1 + (seed >> 16) % maxLen;
+            Buffer buf;
+            for (size_t i = 0; i < len; i++) buf.push_back(static_cast<int>(seed ^ i));
+            for (int v : buf) checksum += v;
+        }
+        batchNs.push_back(chrono::duration<double, nano>(Clock::now() - batchStart).count() / 1000.0);
+    }
+    double totalMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    size_t allocs = AllocCounter::allocations - allocsBefore;
+    checksumSink += checksum;
+
+    sort(batchNs.begin(), batchNs.end());
+    double p50 = batchNs[batchNs.size() / 2];
+    double p99 = batchNs[batchNs.size() * 99 / 100];
+    cout << "  " << name << ": " << totalMs << " ms, " << allocs << " allocations, "
+         << "p50 " << p50 << " ns/op, p99 " << p99 << " ns/op\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  SMALL VECTOR & STATIC VECTOR\n";
+    cout << "========================================\n";
+
+    // ===== RUNTIME SIZE WITHOUT A VLA =====
+    cout << "\n--- small_vector instead of int arr5[n] ---\n";
+    size_t n = 5;  // main.cpp reads this with cin >> n
+    small_vector<int, 16> arr5(n);
+    for (size_t i = 0; i < n; i++) arr5[i] = static_cast<int>(i * i);
+    for (int v : arr5) cout << v << " ";
+    cout << "(inline: " << boolalpha << arr5.is_inline() << ")\n";
+
+    for (int i = 0; i < 20; i++) arr5.push_back(i);
+    cout << "after 20 more: size " << arr5.size() << ", inline: " << arr5.is_inline() << "\n";
+
+    // ===== STATIC VECTOR =====
+    cout << "\n--- static_vector (never allocates) ---\n";
+    static_vector<string, 4> names = {"Nithwin", "BMW"};
+    names.push_back("Yamaha");
+    names.emplace_back("Honda");
+    for (const string &s : names) cout << s << " ";
+    cout << "\n";
+    try {
+        names.push_back("Purple");
+    } catch (const length_error &e) {
+        cout << "push_back on a full static_vector: " << e.what() << "\n";
+    }
+
+    // ===== BENCHMARK =====
+    // ./smallvec 10000000
+    size_t ops = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    ops = max<size_t>(ops / 1000, 1) * 1000;
+
+    cout << "\n--- BENCHMARK: short-lived buffers of 1..16 ints ---\n";
+    benchmark<vector<int>>("std::vector<int>          ", ops, 16);
+    benchmark<small_vector<int, 16>>("small_vector<int, 16>     ", ops, 16);
+    benchmark<static_vector<int, 16>>("static_vector<int, 16>    ", ops, 16);
+
+    cout << "\n--- BENCHMARK: 1..64 ints (small_vector falls back to the heap) ---\n";
+    benchmark<vector<int>>("std::vector<int>          ", ops, 64);
+    benchmark<small_vector<int, 16>>("small_vector<int, 16>     ", ops, 64);
+    benchmark<small_vector<int, 64>>("small_vector<int, 64>     ", ops, 64);
+    cout << "(checksum " << checksumSink << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. VLAs ARE NOT C++:
+   - int arr[n] with a runtime n is a compiler extension
+   - Use vector<int>(n), or small_vector when n is usually small
+
+2. INLINE STORAGE:
+   - Raw bytes inside the object hold the first N elements
+   - Placement new constructs only the elements that exist
+   - No malloc/free for small sizes: faster and no allocator contention
+
+3. HEAP FALLBACK:
+   - Beyond N, grow like std::vector (double the capacity)
+   - Move elements only if the move cannot throw (else copy)
+
+4. STATIC VECTOR:
+   - Fixed capacity, variable size, never allocates
+   - Pushing past the capacity throws length_error
+
+5. TRADE-OFFS:
+   - Bigger objects (N * sizeof(T) inline)
+   - Moving an inline small_vector moves every element
+   - Pick N from real size statistics (e.g. the 95th percentile)
+
+COMPILATION:
+    g++ -std=c++17 -O2 18_Small_Vector.cpp -o smallvec && ./smallvec
+
+NEXT STEP: Store matrices in one flat block!
+*/
@@ -0,0 +1,544 @@
+/*
+=============================================================
+     CONTIGUOUS MATRIX - PERFORMANCE TUTORIAL
+     File: 19_Matrix.cpp
+=============================================================
+Learn: flat row-major / column-major storage, strides, padded aligned
+       rows, mdspan-style views, cache blocking (tiling)
+
+main4.cpp builds a 2D grid out of nested vectors:
+
+    vector<vector<int>> arr(1, vector<int>(10,5));
+
+and main.cpp uses a built-in 2D array:
+
+    int arr2D[2][2] = {{1, 2}, {3, 2}};
+
+int arr2D[2][2] is one contiguous block, but its size is fixed at compile
+time. vector<vector<int>> has a runtime size, but every row is its own
+heap allocation: rows end up scattered across memory, arr[i][j] loads
+two pointers before the value, and nothing guarantees alignment.
+
+Matrix<T> keeps the runtime size and gets the single block back:
+  - ONE aligned allocation, element (i, j) at data[i * stride0 + j * stride1]
+  - row-major OR column-major layout
+  - every row (or column) padded to start on a 64-byte boundary
+  - MatrixView<T>: a non-owning (pointer, extents, strides) view like
+    C++23 std::mdspan with layout_stride; slicing and transposing a
+    view copies nothing
+  - blocked transpose and multiply kernels that work tile by tile
+*/
+
+#include <iostream>
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= MATRIX VIEW =============
+
+enum class Layout { RowMajor, ColMajor };
+
+/*
+A view is just a pointer plus two extents and two strides (in elements):
+
+    (i, j)  ->  data[i * stride(0) + j * stride(1)]
+
+Row-major:    stride(0) = padded row length, stride(1) = 1
+Column-major: stride(0) = 1, stride(1) = padded column length
+Transposed:   swap the extents and the strides
+
+A sub-block is the same strides with the pointer moved to its corner,
+so slicing and transposing cost nothing. MatrixView<const T> is the
+read-only version. Like mdspan, it never owns or frees memory.
+*/
+template <typename T>
+class MatrixView {
+    private:
+        T *data_ = nullptr;
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        ptrdiff_t rowStride_ = 0;
+        ptrdiff_t colStride_ = 0;
+
+    public:
+        MatrixView() = default;
+
+        MatrixView(T *data, size_t rows, size_t cols, ptrdiff_t rowStride, ptrdiff_t colStride)
+            : data_(data), rows_(rows), cols_(cols), rowStride_(rowStride), colStride_(colStride) {}
+
+        // MatrixView<T> converts to MatrixView<const T>
+        template <typename U, typename = enable_if_t<is_same_v<const U, T>>>
+        MatrixView(const MatrixView<U> &other)
+            : MatrixView(other.data(), other.rows(), other.cols(), other.stride(0), other.stride(1)) {}
+
+        T& operator()(size_t i, size_t j) const {
+            return data_[ptrdiff_t(i) * rowStride_ + ptrdiff_t(j) * colStride_];
+        }
+
+        T& at(size_t i, size_t j) const {
+            if (i >= rows_ || j >= cols_) throw out_of_range("MatrixView::at");
+            return (*this)(i, j);
+        }
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t extent(int dim) const { return dim == 0 ? rows_ : cols_; }
+        ptrdiff_t stride(int dim) const { return dim == 0 ? rowStride_ : colStride_; }
+        T* data() const { return data_; }
+
+        // true when each row is a plain contiguous array
+        bool rowContiguous() const { return colStride_ == 1; }
+
+        // rows [r, r + nrows) x columns [c, c + ncols)
+        MatrixView submatrix(size_t r, size_t c, size_t nrows, size_t ncols) const {
+            if (r + nrows > rows_ || c + ncols > cols_) throw out_of_range("MatrixView::submatrix");
+            return MatrixView(&(*this)(r, c), nrows, ncols, rowStride_, colStride_);
+        }
+
+        MatrixView row(size_t i) const { return submatrix(i, 0, 1, cols_); }
+        MatrixView col(size_t j) const { return submatrix(0, j, rows_, 1); }
+
+        MatrixView transposed() const {
+            return MatrixView(data_, cols_, rows_, colStride_, rowStride_);
+        }
+};
+
+// ============= MATRIX =============
+
+/*
+Owns one block of rows x cols elements (plus padding).
+
+The leading dimension (distance between the starts of two rows, or two
+columns for ColMajor) is rounded up to a multiple of 64 bytes, and the
+block itself is 64-byte aligned. Every row then starts on its own cache
+line, and SIMD loads of a row never straddle a line at the start. Row
+lengths that are a multiple of 4 KB get one more line, otherwise walking
+down a column hits the same few cache sets over and over (a 4096 x 4096
+int matrix would transpose twice as slowly).
+
+Numbers only (trivially copyable T): the block is filled with memset /
+memcpy and never runs constructors.
+*/
+template <typename T>
+class Matrix {
+    static_assert(is_trivially_copyable_v<T>, "Matrix<T> is for plain numeric types");
+
+    private:
+        static constexpr size_t ALIGNMENT = 64;
+
+        T *data_ = nullptr;
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        size_t ld_ = 0;  // leading dimension, in elements
+        Layout layout_ = Layout::RowMajor;
+
+        static size_t paddedLength(size_t n) {
+            if (ALIGNMENT % sizeof(T) != 0) return n;
+            size_t perLine = ALIGNMENT / sizeof(T);
+            size_t padded = (n + perLine - 1) / perLine * perLine;
+            // A row length that is a multiple of 4 KB maps every element of a column
+            // to the same cache set; one extra line breaks that up.
+            if (n > perLine && (padded * sizeof(T)) % 4096 == 0) padded += perLine;
+            return padded;
+        }
+
+        size_t allocated() const {
+            return ld_ * (layout_ == Layout::RowMajor ? rows_ : cols_);
+        }
+
+        static T* allocate(size_t count) {
+            if (count == 0) return nullptr;
+            return static_cast<T*>(::operator new(count * sizeof(T), align_val_t(ALIGNMENT)));
+        }
+
+        void release() {
+            if (data_) ::operator delete(data_, align_val_t(ALIGNMENT));
+            data_ = nullptr;
+        }
+
+    public:
+        Matrix() = default;
+
+        Matrix(size_t rows, size_t cols, Layout layout = Layout::RowMajor)
+            : rows_(rows), cols_(cols),
+              ld_(paddedLength(layout == Layout::RowMajor ? cols : rows)),
+              layout_(layout) {
+            data_ = allocate(allocated());
+            if (data_) memset(data_, 0, allocated() * sizeof(T));
+        }
+
+        Matrix(size_t rows, size_t cols, T value, Layout layout = Layout::RowMajor)
+            : Matrix(rows, cols, layout) {
+            fill(value);
+        }
+
+        Matrix(const Matrix &other)
+            : rows_(other.rows_), cols_(other.cols_), ld_(other.ld_), layout_(other.layout_) {
+            data_ = allocate(allocated());
+            if (data_) memcpy(data_, other.data_, allocated() * sizeof(T));
+        }
+
+        Matrix(Matrix &&other) noexcept
+            : data_(other.data_), rows_(other.rows_), cols_(other.cols_),
+              ld_(other.ld_), layout_(other.layout_) {
+            other.data_ = nullptr;
+            other.rows_ = other.cols_ = other.ld_ = 0;
+        }
+
+        Matrix& operator=(Matrix other) noexcept {
+            swap(data_, other.data_);
+            swap(rows_, other.rows_);
+            swap(cols_, other.cols_);
+            swap(ld_, other.ld_);
+            swap(layout_, other.layout_);
+            return *this;
+        }
+
+        ~Matrix() {
+            release();
+        }
+
+        T& operator()(size_t i, size_t j) {
+            return layout_ == Layout::RowMajor ? data_[i * ld_ + j] : data_[j * ld_ + i];
+        }
+        const T& operator()(size_t i, size_t j) const {
+            return layout_ == Layout::RowMajor ? data_[i * ld_ + j] : data_[j * ld_ + i];
+        }
+
+        T& at(size_t i, size_t j) {
+            if (i >= rows_ || j >= cols_) throw out_of_range("Matrix::at");
+            return (*this)(i, j);
+        }
+
+        void fill(T value) {
+            for (size_t i = 0; i < rows_; i++)
+                for (size_t j = 0; j < cols_; j++) (*this)(i, j) = value;
+        }
+
+        MatrixView<T> view() {
+            return layout_ == Layout::RowMajor
+                ? MatrixView<T>(data_, rows_, cols_, ptrdiff_t(ld_), 1)
+                : MatrixView<T>(data_, rows_, cols_, 1, ptrdiff_t(ld_));
+        }
+        MatrixView<const T> view() const {
+            return const_cast<Matrix*>(this)->view();
+        }
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t leadingDimension() const { return ld_; }
+        Layout layout() const { return layout_; }
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+};
+
+// ============= BLOCKED KERNELS =============
+
+/*
+Naive transpose reads src row by row but writes dst column by column:
+every write lands on a different cache line, and for big matrices that
+line is evicted before the next write to it. Working on TILE x TILE
+blocks keeps both the source rows and the destination rows of one block
+in L1 (32 x 32 ints = 4 KB each), so every line is fully used once loaded.
+*/
+template <typename T>
+void transposeBlocked(MatrixView<const T> src, MatrixView<T> dst, size_t tile = 32) {
+    if (dst.rows() != src.cols() || dst.cols() != src.rows()) {
+        throw invalid_argument("transposeBlocked: dst must be cols x rows of src");
+    }
+    for (size_t ii = 0; ii < src.rows(); ii += tile) {
+        size_t iEnd = min(ii + tile, src.rows());
+        for (size_t jj = 0; jj < src.cols(); jj += tile) {
+            size_t jEnd = min(jj + tile, src.cols());
+            for (size_t i = ii; i < iEnd; i++)
+                for (size_t j = jj; j < jEnd; j++) dst(j, i) = src(i, j);
+        }
+    }
+}
+
+/*
+C = A * B, blocked in all three loops.
+
+Inside a block the loop order is i, k, j: A(i, k) is fixed while j runs
+along a row of B and a row of C. With row-major B and C those rows are
+contiguous, so the inner loop is a plain "c[j] += a * b[j]" that the
+compiler vectorizes. The tile keeps a TILE x TILE block of B in cache
+while it is reused for every row i of the block.
+
+Any layout works (views carry their strides); row-major B and C take
+the pointer fast path below.
+*/
+// One tile with row-major B and C. For 8 columns of C at a time the sums
+// stay in registers across the whole k loop, so each step is one load of
+// B and one multiply-add instead of load C / load B / store C. Plain
+// 8-wide unrolled code: at -O2 GCC turns the acc[] updates into vector ops.
+template <typename T>
+void multiplyTileContiguous(MatrixView<const T> a, const T *b, ptrdiff_t ldb, T *c, ptrdiff_t ldc,
+                            size_t ii, size_t iEnd, size_t kk, size_t kEnd, size_t jj, size_t jEnd) {
+    for (size_t i = ii; i < iEnd; i++) {
+        T *__restrict cRow = c + ptrdiff_t(i) * ldc;
+        size_t j = jj;
+        for (; j + 8 <= jEnd; j += 8) {
+            T acc[8];
+            for (int l = 0; l < 8; l++) acc[l] = cRow[j + l];
+            for (size_t k = kk; k < kEnd; k++) {
+                T aik = a(i, k);
+                const T *__restrict bRow = b + ptrdiff_t(k) * ldb + j;
+                for (int l = 0; l < 8; l++) acc[l] += aik * bRow[l];
+            }
+            for (int l = 0; l < 8; l++) cRow[j + l] = acc[l];
+        }
+        for (; j < jEnd; j++) {
+            T sum = cRow[j];
+            for (size_t k = kk; k < kEnd; k++) sum += a(i, k) * b[ptrdiff_t(k) * ldb + ptrdiff_t(j)];
+            cRow[j] = sum;
+        }
+    }
+}
+
+template <typename T>
+void multiplyBlocked(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c, size_t tile = 32) {
+    if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+        throw invalid_argument("multiplyBlocked: shape mismatch");
+    }
+    for (size_t i = 0; i < c.rows(); i++)
+        for (size_t j = 0; j < c.cols(); j++) c(i, j) = T();
+
+    bool contiguous = b.rowContiguous() && c.rowContiguous();
+    for (size_t ii = 0; ii < a.rows(); ii += tile) {
+        size_t iEnd = min(ii + tile, a.rows());
+        for (size_t kk = 0; kk < a.cols(); kk += tile) {
+            size_t kEnd = min(kk + tile, a.cols());
+            for (size_t jj = 0; jj < b.cols(); jj += tile) {
+                size_t jEnd = min(jj + tile, b.cols());
+                if (contiguous) {
+                    multiplyTileContiguous(a, b.data(), b.stride(0), c.data(), c.stride(0),
+                                           ii, iEnd, kk, kEnd, jj, jEnd);
+                    continue;
+                }
+                for (size_t i = ii; i < iEnd; i++)
+                    for (size_t k = kk; k < kEnd; k++) {
+                        T aik = a(i, k);
+                        for (size_t j = jj; j < jEnd; j++) c(i, j) += aik * b(k, j);
+                    }
+            }
+        }
+    }
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+long long sink = 0;  // printed at the end so results are not optimized away
+
+void benchmarkTraversal(size_t n) {
+    cout << "\n--- BENCHMARK: sum " << n << " x " << n << " ints ---\n";
+    vector<vector<int>> nested(n, vector<int>(n));
+    Matrix<int> flat(n, n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) nested[i][j] = flat(i, j) = int((i * 31 + j) & 1023);
+
+    long long s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+    double nestedRows = timeMs([&] {
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) s1 += nested[i][j];
+    });
+    double nestedCols = timeMs([&] {
+        for (size_t j = 0; j < n; j++)
+            for (size_t i = 0; i < n; i++) s2 += nested[i][j];
+    });
+    MatrixView<const int> v = flat.view();
+    double flatRows = timeMs([&] {
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) s3 += v(i, j);
+    });
+    double flatCols = timeMs([&] {
+        for (size_t j = 0; j < n; j++)
+            for (size_t i = 0; i < n; i++) s4 += v(i, j);
+    });
+    sink += s1 + s2 + s3 + s4;
+
+    cout << "  vector<vector<int>>, row order   : " << nestedRows << " ms\n";
+    cout << "  vector<vector<int>>, column order: " << nestedCols << " ms\n";
+    cout << "  Matrix<int>, row order           : " << flatRows << " ms\n";
+    cout << "  Matrix<int>, column order        : " << flatCols << " ms\n";
+    cout << "  sums match: " << boolalpha << (s1 == s2 && s2 == s3 && s3 == s4) << "\n";
+}
+
+void benchmarkTranspose(size_t n) {
+    cout << "\n--- BENCHMARK: transpose " << n << " x " << n << " ints ---\n";
+    vector<vector<int>> nested(n, vector<int>(n)), nestedT(n, vector<int>(n));
+    Matrix<int> flat(n, n), flatT(n, n), flatBlockedT(n, n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) nested[i][j] = flat(i, j) = int(i * n + j);
+
+    double nestedMs = timeMs([&] {
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) nestedT[j][i] = nested[i][j];
+    });
+    double naiveMs = timeMs([&] {
+        MatrixView<const int> src = flat.view();
+        MatrixView<int> dst = flatT.view();
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) dst(j, i) = src(i, j);
+    });
+    double blockedMs = timeMs([&] {
+        transposeBlocked<int>(flat.view(), flatBlockedT.view());
+    });
+
+    bool same = true;
+    for (size_t i = 0; i < n && same; i++)
+        for (size_t j = 0; j < n; j++)
+            if (nestedT[i][j] != flatBlockedT(i, j) || flatT(i, j) != flatBlockedT(i, j)) { same = false; break; }
+
+    cout << "  vector<vector<int>>, naive: " << nestedMs << " ms\n";
+    cout << "  Matrix<int>, naive        : " << naiveMs << " ms\n";
+    cout << "  Matrix<int>, blocked      : " << blockedMs << " ms\n";
+    cout << "  results match: " << boolalpha << same << "\n";
+}
+
+void benchmarkMultiply(size_t n) {
+    cout << "\n--- BENCHMARK: multiply " << n << " x " << n << " doubles ---\n";
+    vector<vector<double>> a(n, vector<double>(n)), b(n, vector<double>(n));
+    vector<vector<double>> c1(n, vector<double>(n)), c2(n, vector<double>(n));
+    Matrix<double> ma(n, n), mb(n, n), mc(n, n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            a[i][j] = ma(i, j) = double((i + 2 * j) % 7) - 3.0;
+            b[i][j] = mb(i, j) = double((3 * i + j) % 5) - 2.0;
+        }
+    }
+
+    // Textbook i, j, k: walks B down a column
+    double ijkMs = timeMs([&] {
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) {
+                double sum = 0;
+                for (size_t k = 0; k < n; k++) sum += a[i][k] * b[k][j];
+                c1[i][j] = sum;
+            }
+    });
+    // Same loops reordered to i, k, j: walks B along rows
+    double ikjMs = timeMs([&] {
+        for (size_t i = 0; i < n; i++)
+            for (size_t k = 0; k < n; k++) {
+                double aik = a[i][k];
+                for (size_t j = 0; j < n; j++) c2[i][j] += aik * b[k][j];
+            }
+    });
+    double blockedMs = timeMs([&] {
+        multiplyBlocked<double>(ma.view(), mb.view(), mc.view());
+    });
+
+    bool same = true;
+    for (size_t i = 0; i < n && same; i++)
+        for (size_t j = 0; j < n; j++)
+            if (c1[i][j] != mc(i, j) || c2[i][j] != mc(i, j)) { same = false; break; }
+
+    double gflop = 2.0 * double(n) * double(n) * double(n) / 1e9;
+    cout << "  vector<vector<double>>, i-j-k: " << ijkMs << " ms (" << gflop / (ijkMs / 1000) << " GFLOP/s)\n";
+    cout << "  vector<vector<double>>, i-k-j: " << ikjMs << " ms (" << gflop / (ikjMs / 1000) << " GFLOP/s)\n";
+    cout << "  Matrix<double>, blocked      : " << blockedMs << " ms (" << gflop / (blockedMs / 1000) << " GFLOP/s)\n";
+    cout << "  results match: " << boolalpha << same << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  CONTIGUOUS MATRIX\n";
+    cout << "========================================\n";
+
+    // ===== BASICS =====
+    cout << "\n--- Matrix instead of vector<vector<int>> ---\n";
+    Matrix<int> arr(1, 10, 5);  // main4.cpp: vector<vector<int>> arr(1, vector<int>(10,5))
+    for (size_t j = 0; j < arr.cols(); j++) cout << arr(0, j) << " ";
+    cout << "\nrow length 10 ints, padded to " << arr.leadingDimension()
+         << ", data 64-byte aligned: " << boolalpha
+         << (reinterpret_cast<uintptr_t>(arr.data()) % 64 == 0) << "\n";
+
+    Matrix<int> arr2D(2, 2);  // main.cpp: int arr2D[2][2] = {{1, 2}, {3, 2}}
+    arr2D(0, 0) = 1; arr2D(0, 1) = 2;
+    arr2D(1, 0) = 3; arr2D(1, 1) = 2;
+    cout << "arr2D(0, 0) = " << arr2D(0, 0) << "\n";
+
+    // ===== VIEWS AND SLICING =====
+    cout << "\n--- Views: slicing and transposing copy nothing ---\n";
+    Matrix<int> m(4, 5);
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = 0; j < 5; j++) m(i, j) = int(i * 10 + j);
+
+    MatrixView<int> block = m.view().submatrix(1, 2, 2, 3);
+    cout << "submatrix(1, 2, 2, 3):\n";
+    for (size_t i = 0; i < block.rows(); i++) {
+        for (size_t j = 0; j < block.cols(); j++) cout << "  " << block(i, j);
+        cout << "\n";
+    }
+    MatrixView<int> t = m.view().transposed();
+    cout << "transposed is " << t.rows() << " x " << t.cols()
+         << ", strides (" << t.stride(0) << ", " << t.stride(1) << "), t(4, 3) = " << t(4, 3) << "\n";
+    block(0, 0) = -1;
+    cout << "writing through the view: m(1, 2) = " << m(1, 2) << "\n";
+
+    Matrix<int> colMajor(4, 5, Layout::ColMajor);
+    cout << "column-major 4 x 5: strides (" << colMajor.view().stride(0) << ", "
+         << colMajor.view().stride(1) << ")\n";
+
+    // ===== BENCHMARKS =====
+    // ./matrix 4096 512
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4096;
+    size_t mulN = argc > 2 ? strtoull(argv[2], nullptr, 10) : 512;
+
+    benchmarkTraversal(n);
+    benchmarkTranspose(n);
+    benchmarkMultiply(mulN);
+    cout << "(checksum " << sink << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ONE BLOCK, NOT ONE VECTOR PER ROW:
+   - vector<vector<T>>: n allocations, rows scattered, two loads per access
+   - Matrix<T>: one allocation, (i, j) -> data[i * stride0 + j * stride1]
+
+2. LAYOUT AND STRIDES:
+   - Row-major: rows are contiguous; column-major: columns are
+   - Traverse in storage order, or the cache works against you
+   - Padding each row to 64 bytes keeps rows cache-line and SIMD aligned
+
+3. VIEWS (mdspan STYLE):
+   - Pointer + extents + strides, never owns memory
+   - Submatrix = move the pointer; transpose = swap the strides
+
+4. CACHE BLOCKING:
+   - Transpose and multiply tile by tile so each loaded line is fully used
+   - Loop order i-k-j makes the inner loop contiguous and vectorizable
+   - Keep a few sums of C in registers across the k loop
+
+COMPILATION:
+    g++ -std=c++17 -O2 19_Matrix.cpp -o matrix && ./matrix
+    ./matrix 4096 512   (transpose size, multiply size)
+
+NEXT STEP: Allocate from an arena instead of the heap!
+*/
@@ -0,0 +1,656 @@
+/*
+=============================================================
+     ARENA & POOL ALLOCATORS - PERFORMANCE TUTORIAL
+     File: 20_Arena_Allocator.cpp
+=============================================================
+Learn: bump (monotonic) allocation, size-class pools, std::pmr,
+       allocator-aware classes, freeing a whole batch at once
+
+03_OOP_Classes.cpp builds objects like this:
+
+    Student(string n, int a, double g, string id) {
+        name = n;
+        age = a;
+        gpa = g;
+        studentID = id;
+        department = "Engineering";
+        ...
+    }
+
+and main8.cpp does the same for Bike(string name, int speed, string color).
+Every string longer than the small-string buffer (15 chars in libstdc++)
+is its own malloc: once for the by-value parameter, once more for the
+copy-assignment into the member, plus a free for the parameter. Build a
+million Students and free them again and the program mostly talks to
+malloc.
+
+This file adds two memory resources that plug into std::pmr:
+  BumpArena    : hands out memory by moving a pointer forward, frees
+                 nothing until release() (or destruction) drops it all
+  PoolResource : free lists per size class (16, 32, ... 512 bytes), so
+                 freed blocks are reused without going back to malloc
+and versions of Student, Car and Bike that take an allocator, so a whole
+batch (the objects AND their strings) lives in one arena.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory_resource>
+#include <new>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+using namespace std;
+
+// ============= BUMP ARENA =============
+
+/*
+Allocation = round the pointer up to the alignment, move it forward.
+No header per block, no free list, no search. Deallocation does nothing;
+memory comes back all at once in release().
+
+When the current chunk is full, a new one twice the size is taken from
+the upstream resource (new/delete by default), so a batch of N objects
+costs about log2(N) real allocations instead of N.
+
+Same idea as std::pmr::monotonic_buffer_resource, written out so the
+mechanics are visible. Not thread-safe: one arena per thread or per batch.
+*/
+class BumpArena : public pmr::memory_resource {
+    private:
+        struct Chunk {
+            Chunk *next;
+            size_t size;
+        };
+
+        pmr::memory_resource *upstream;
+        Chunk *chunks = nullptr;
+        char *cur = nullptr;
+        char *end = nullptr;
+        size_t initialSize;
+        size_t nextSize;
+        size_t chunkCount = 0;
+
+        void grow(size_t bytes, size_t alignment) {
+            size_t need = sizeof(Chunk) + bytes + alignment;
+            size_t size = max(nextSize, need);
+            auto *chunk = static_cast<Chunk*>(upstream->allocate(size, alignof(max_align_t)));
+            chunk->next = chunks;
+            chunk->size = size;
+            chunks = chunk;
+            cur = reinterpret_cast<char*>(chunk + 1);
+            end = reinterpret_cast<char*>(chunk) + size;
+            nextSize = size * 2;
+            chunkCount++;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            uintptr_t p = (reinterpret_cast<uintptr_t>(cur) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            if (!cur || p + bytes > reinterpret_cast<uintptr_t>(end)) {
+                grow(bytes, alignment);
+                p = (reinterpret_cast<uintptr_t>(cur) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            }
+            cur = reinterpret_cast<char*>(p + bytes);
+            return reinterpret_cast<void*>(p);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        explicit BumpArena(size_t initialSize = 64 * 1024,
+                           pmr::memory_resource *upstream = pmr::new_delete_resource())
+            : upstream(upstream), initialSize(initialSize), nextSize(initialSize) {}
+
+        BumpArena(const BumpArena&) = delete;
+        BumpArena& operator=(const BumpArena&) = delete;
+
+        ~BumpArena() override {
+            release();
+        }
+
+        // Frees every chunk. Objects in the arena must already be destroyed
+        // (or be trivially destructible).
+        void release() {
+            while (chunks) {
+                Chunk *next = chunks->next;
+                upstream->deallocate(chunks, chunks->size, alignof(max_align_t));
+                chunks = next;
+            }
+            cur = end = nullptr;
+            nextSize = initialSize;
+            chunkCount = 0;
+        }
+
+        size_t chunksAllocated() const { return chunkCount; }
+};
+
+// ============= POOL RESOURCE =============
+
+/*
+A bump arena never reuses memory, so objects that are created and
+destroyed over and over (instead of in one batch) keep growing it.
+
+A pool keeps one free list per size class. Freed blocks are pushed on
+the list of their class (the free-list link is stored inside the freed
+block itself) and the next allocation of that class pops it: both are a
+couple of instructions. Empty lists are refilled by carving a 64 KB
+block from upstream into equal pieces. Requests above 512 bytes go
+straight to upstream.
+
+Same idea as std::pmr::unsynchronized_pool_resource.
+*/
+class PoolResource : public pmr::memory_resource {
+    private:
+        static constexpr size_t MIN_CLASS = 16;
+        static constexpr size_t MAX_CLASS = 512;
+        static constexpr size_t CLASS_COUNT = 6;  // 16, 32, 64, 128, 256, 512
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+        struct FreeNode {
+            FreeNode *next;
+        };
+
+        pmr::memory_resource *upstream;
+        FreeNode *freeLists[CLASS_COUNT] = {};
+        vector<void*> blocks;
+
+        static size_t classIndex(size_t bytes) {
+            size_t index = 0;
+            for (size_t size = MIN_CLASS; size < bytes; size *= 2) index++;
+            return index;
+        }
+
+        void refill(size_t index) {
+            size_t size = MIN_CLASS << index;
+            char *block = static_cast<char*>(upstream->allocate(BLOCK_SIZE, alignof(max_align_t)));
+            blocks.push_back(block);
+            // Link the pieces front to back so consecutive allocations are adjacent
+            size_t count = BLOCK_SIZE / size;
+            for (size_t k = 0; k + 1 < count; k++) {
+                reinterpret_cast<FreeNode*>(block + k * size)->next = reinterpret_cast<FreeNode*>(block + (k + 1) * size);
+            }
+            reinterpret_cast<FreeNode*>(block + (count - 1) * size)->next = freeLists[index];
+            freeLists[index] = reinterpret_cast<FreeNode*>(block);
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            size_t size = max(bytes, alignment);
+            if (size > MAX_CLASS || alignment > alignof(max_align_t)) {
+                return upstream->allocate(bytes, alignment);
+            }
+            size_t index = classIndex(size);
+            if (!freeLists[index]) refill(index);
+            FreeNode *node = freeLists[index];
+            freeLists[index] = node->next;
+            return node;
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+            size_t size = max(bytes, alignment);
+            if (size > MAX_CLASS || alignment > alignof(max_align_t)) {
+                upstream->deallocate(p, bytes, alignment);
+                return;
+            }
+            size_t index = classIndex(size);
+            auto *node = static_cast<FreeNode*>(p);
+            node->next = freeLists[index];
+            freeLists[index] = node;
+        }
+
+        bool do_is_equal(const pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        explicit PoolResource(pmr::memory_resource *upstream = pmr::new_delete_resource())
+            : upstream(upstream) {}
+
+        PoolResource(const PoolResource&) = delete;
+        PoolResource& operator=(const PoolResource&) = delete;
+
+        ~PoolResource() override {
+            release();
+        }
+
+        void release() {
+            for (void *block : blocks) upstream->deallocate(block, BLOCK_SIZE, alignof(max_align_t));
+            blocks.clear();
+            fill(begin(freeLists), end(freeLists), nullptr);
+        }
+
+        size_t blocksAllocated() const { return blocks.size(); }
+};
+
+// ============= ORIGINAL CLASSES =============
+
+// Student and Car from 03_OOP_Classes.cpp, Bike from main8.cpp, as they
+// build their members (the cout in Student's constructor is left out)
+class StudentOriginal {
+    private:
+        double gpa;
+        string studentID;
+
+    protected:
+        string department;
+
+    public:
+        string name;
+        int age;
+
+        StudentOriginal(string n, int a, double g, string id) {
+            name = n;
+            age = a;
+            gpa = g;
+            studentID = id;
+            department = "Electrical Engineering";
+        }
+
+        double getGPA() { return gpa; }
+};
+
+class CarOriginal {
+    private:
+        string model;
+        int year;
+        double speed;
+
+    public:
+        string color;
+        string brand;
+
+        CarOriginal(string b, string c, string m, int y) {
+            brand = b;
+            color = c;
+            model = m;
+            year = y;
+            speed = 0;
+        }
+
+        int getYear() { return year; }
+};
+
+class BikeOriginal {
+    protected:
+        string name;
+        int speed;
+        string color;
+
+    public:
+        BikeOriginal(string name, int speed, string color) {
+            this->name = name;
+            this->speed = speed;
+            this->color = color;
+        }
+
+        int getSpeed() { return speed; }
+};
+
+// ============= ALLOCATOR-AWARE CLASSES =============
+
+/*
+Allocator-aware = every string member is a pmr::string, the class
+declares allocator_type, and every constructor takes an optional
+allocator as its last argument and passes it to the members.
+
+Because of the allocator_type typedef, a pmr::vector<Student> hands ITS
+allocator to each element it constructs (uses-allocator construction):
+put the vector in an arena and every Student and every string inside it
+lands in the same arena.
+
+Parameters are string_view: no temporary string is built for the call,
+and the member is constructed once, directly in the arena, in the
+member-init list (no default-construct + assign).
+*/
+class Student {
+    private:
+        double gpa;
+        pmr::string studentID;
+
+    protected:
+        pmr::string department;
+
+    public:
+        using allocator_type = pmr::polymorphic_allocator<char>;
+
+        pmr::string name;
+        int age;
+
+        Student(string_view n, int a, double g, string_view id, const allocator_type &alloc = {})
+            : gpa(g), studentID(id, alloc), department("Electrical Engineering", alloc),
+              name(n, alloc), age(a) {}
+
+        // Copies and moves may target a different arena
+        Student(const Student &other, const allocator_type &alloc = {})
+            : gpa(other.gpa), studentID(other.studentID, alloc), department(other.department, alloc),
+              name(other.name, alloc), age(other.age) {}
+
+        Student(Student &&other) noexcept = default;
+
+        Student(Student &&other, const allocator_type &alloc)
+            : gpa(other.gpa), studentID(move(other.studentID), alloc),
+              department(move(other.department), alloc), name(move(other.name), alloc),
+              age(other.age) {}
+
+        Student& operator=(const Student&) = default;
+        Student& operator=(Student&&) = default;
+
+        allocator_type get_allocator() const { return name.get_allocator(); }
+
+        double getGPA() const { return gpa; }
+        const pmr::string& getID() const { return studentID; }
+};
+
+class Car {
+    private:
+        pmr::string model;
+        int year;
+        double speed = 0;
+
+    public:
+        using allocator_type = pmr::polymorphic_allocator<char>;
+
+        pmr::string color;
+        pmr::string brand;
+
+        Car(string_view b, string_view c, string_view m, int y, const allocator_type &alloc = {})
+            : model(m, alloc), year(y), color(c, alloc), brand(b, alloc) {}
+
+        Car(const Car &other, const allocator_type &alloc = {})
+            : model(other.model, alloc), year(other.year), speed(other.speed),
+              color(other.color, alloc), brand(other.brand, alloc) {}
+
+        Car(Car &&other) noexcept = default;
+
+        Car(Car &&other, const allocator_type &alloc)
+            : model(move(other.model), alloc), year(other.year), speed(other.speed),
+              color(move(other.color), alloc), brand(move(other.brand), alloc) {}
+
+        Car& operator=(const Car&) = default;
+        Car& operator=(Car&&) = default;
+
+        allocator_type get_allocator() const { return model.get_allocator(); }
+
+        int getYear() const { return year; }
+        const pmr::string& getModel() const { return model; }
+};
+
+class Bike {
+    protected:
+        pmr::string name;
+        int speed;
+        pmr::string color;
+
+    public:
+        using allocator_type = pmr::polymorphic_allocator<char>;
+
+        Bike(string_view name, int speed, string_view color, const allocator_type &alloc = {})
+            : name(name, alloc), speed(speed), color(color, alloc) {}
+
+        Bike(const Bike &other, const allocator_type &alloc = {})
+            : name(other.name, alloc), speed(other.speed), color(other.color, alloc) {}
+
+        Bike(Bike &&other) noexcept = default;
+
+        Bike(Bike &&other, const allocator_type &alloc)
+            : name(move(other.name), alloc), speed(other.speed), color(move(other.color), alloc) {}
+
+        Bike& operator=(const Bike&) = default;
+        Bike& operator=(Bike&&) = default;
+
+        allocator_type get_allocator() const { return name.get_allocator(); }
+
+        const pmr::string& getName() const { return name; }
+        int getSpeed() const { return speed; }
+        const pmr::string& getColor() const { return color; }
+};
+
+// ============= ALLOCATION COUNTING =============
+
+/*
+Replacing the global operator new lets the benchmark count every call
+that reaches the real heap (the arenas' own chunks included).
+*/
+struct AllocCounter {
+    static inline size_t allocations = 0;
+};
+
+void *operator new(size_t size) {
+    AllocCounter::allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+// pmr::new_delete_resource() asks for aligned memory, so count that path too
+void *operator new(size_t size, align_val_t alignment) {
+    AllocCounter::allocations++;
+    size_t align = max(static_cast<size_t>(alignment), sizeof(void*));
+    void *p = aligned_alloc(align, (max<size_t>(size, 1) + align - 1) / align * align);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p, align_val_t) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t, align_val_t) noexcept {
+    free(p);
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Names longer than 15 chars, so libstdc++'s small-string buffer does not hide the mallocs
+struct Names {
+    vector<string> people, ids, models, colors;
+
+    explicit Names(size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            people.push_back("Student Number " + to_string(100000 + i));
+            ids.push_back("ID-2024-ENGINEERING-" + to_string(i));
+            models.push_back("Model Series " + to_string(i % 97) + " Touring");
+            colors.push_back(i % 2 ? "Midnight Purple Metallic" : "Racing Green Pearlescent");
+        }
+    }
+};
+
+long long sink = 0;  // printed at the end so the work is not optimized away
+
+void report(const char *label, double ms, size_t objects, size_t allocs) {
+    cout << "  " << label << ": " << ms << " ms, "
+         << objects / (ms * 1000.0) << " M objects/s, "
+         << allocs << " heap allocations\n";
+}
+
+// One round = build n Students, n Cars and n Bikes in vectors, then free everything
+void benchmark(size_t n, size_t rounds) {
+    Names names(n);
+    size_t objects = 3 * n * rounds;
+    cout << "\n--- BENCHMARK: " << rounds << " x (" << n << " Students + Cars + Bikes) ---\n";
+
+    size_t before = AllocCounter::allocations;
+    double ms = timeMs([&] {
+        for (size_t r = 0; r < rounds; r++) {
+            vector<StudentOriginal> students;
+            vector<CarOriginal> cars;
+            vector<BikeOriginal> bikes;
+            students.reserve(n);
+            cars.reserve(n);
+            bikes.reserve(n);
+            for (size_t i = 0; i < n; i++) {
+                students.emplace_back(names.people[i], 20, 3.5, names.ids[i]);
+                cars.emplace_back("Bayerische Motoren Werke", names.colors[i], names.models[i], 2024);
+                bikes.emplace_back(names.models[i], 120, names.colors[i]);
+            }
+            sink += students.back().age + cars.back().getYear() + bikes.back().getSpeed();
+        }
+    });
+    report("original (string by value)  ", ms, objects, AllocCounter::allocations - before);
+
+    auto buildRound = [&](pmr::memory_resource *resource) {
+        pmr::vector<Student> students(resource);
+        pmr::vector<Car> cars(resource);
+        pmr::vector<Bike> bikes(resource);
+        students.reserve(n);
+        cars.reserve(n);
+        bikes.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            students.emplace_back(names.people[i], 20, 3.5, names.ids[i]);
+            cars.emplace_back("Bayerische Motoren Werke", names.colors[i], names.models[i], 2024);
+            bikes.emplace_back(names.models[i], 120, names.colors[i]);
+        }
+        sink += students.back().age + cars.back().getYear() + bikes.back().getSpeed();
+    };
+
+    // Allocator-aware classes, still on the plain heap
+    before = AllocCounter::allocations;
+    ms = timeMs([&] {
+        for (size_t r = 0; r < rounds; r++) buildRound(pmr::new_delete_resource());
+    });
+    report("string_view + init list     ", ms, objects, AllocCounter::allocations - before);
+
+    // One arena for all rounds: release() after each round frees the batch
+    before = AllocCounter::allocations;
+    ms = timeMs([&] {
+        BumpArena arena;
+        for (size_t r = 0; r < rounds; r++) {
+            buildRound(&arena);
+            arena.release();
+        }
+    });
+    report("BumpArena, release per round", ms, objects, AllocCounter::allocations - before);
+
+    before = AllocCounter::allocations;
+    ms = timeMs([&] {
+        PoolResource pool;
+        for (size_t r = 0; r < rounds; r++) buildRound(&pool);
+    });
+    report("PoolResource                ", ms, objects, AllocCounter::allocations - before);
+
+    before = AllocCounter::allocations;
+    ms = timeMs([&] {
+        pmr::unsynchronized_pool_resource pool;
+        for (size_t r = 0; r < rounds; r++) buildRound(&pool);
+    });
+    report("std unsynchronized_pool     ", ms, objects, AllocCounter::allocations - before);
+
+    before = AllocCounter::allocations;
+    ms = timeMs([&] {
+        for (size_t r = 0; r < rounds; r++) {
+            pmr::monotonic_buffer_resource arena;
+            buildRound(&arena);
+        }
+    });
+    report("std monotonic_buffer        ", ms, objects, AllocCounter::allocations - before);
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  ARENA & POOL ALLOCATORS\n";
+    cout << "========================================\n";
+
+    // ===== ONE ARENA FOR A WHOLE BATCH =====
+    cout << "\n--- Building a batch in one arena ---\n";
+    {
+        BumpArena arena(4096);
+        size_t before = AllocCounter::allocations;
+
+        pmr::vector<Bike> garage(&arena);
+        garage.emplace_back("Yamaha YZF-R15 Version 4", 140, "Racing Blue Metallic");
+        garage.emplace_back("BMW S 1000 RR Motorsport", 299, "Light White Uni");
+        Student s("Nithwin Kumar Subramanian", 21, 3.8, "ENG-2024-000017", &arena);
+        Car c("Bayerische Motoren Werke", "Midnight Purple", "M340i xDrive Touring", 2024, &arena);
+
+        for (const Bike &b : garage) cout << b.getName() << " (" << b.getColor() << ")\n";
+        cout << s.name << ", " << s.getID() << "\n";
+        cout << c.brand << " " << c.getModel() << "\n";
+        cout << "every string is in the arena: " << boolalpha
+             << (garage[0].get_allocator().resource() == &arena && s.get_allocator().resource() == &arena) << "\n";
+        cout << "heap allocations: " << AllocCounter::allocations - before
+             << " (arena chunks: " << arena.chunksAllocated() << ")\n";
+    }   // objects destroyed, then the arena frees its chunks in one go
+
+    // ===== COPYING OUT OF AN ARENA =====
+    cout << "\n--- Copying into another resource ---\n";
+    {
+        BumpArena arena;
+        Bike temp("Kawasaki Ninja ZX-10R SE", 299, "Lime Green Ebony", &arena);
+        Bike kept(temp, pmr::new_delete_resource());  // survives the arena
+        cout << kept.getName() << " now uses "
+             << (kept.get_allocator().resource() == pmr::new_delete_resource() ? "new/delete" : "the arena") << "\n";
+    }
+
+    // ===== BENCHMARK =====
+    // ./arena 200000 5
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 200000;
+    size_t rounds = argc > 2 ? strtoull(argv[2], nullptr, 10) : 5;
+    benchmark(n, rounds);
+    cout << "(checksum " << sink << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. WHERE THE TIME GOES:
+   - string by value + assignment in the body = 2 mallocs + 1 free per member
+   - string_view parameters + member-init list = 1 allocation, no copy
+
+2. BUMP ARENA:
+   - Allocate = align + add; deallocate = nothing
+   - Whole batch freed with one release()
+   - Chunks double in size: about log2(N) real allocations
+
+3. POOL:
+   - One free list per size class; free blocks store the list link
+   - Reuses memory when objects come and go individually
+
+4. std::pmr:
+   - memory_resource: do_allocate / do_deallocate / do_is_equal
+   - polymorphic_allocator carries a pointer to the resource
+   - allocator_type + allocator-extended constructors make a class
+     allocator-aware; pmr containers pass their resource down
+
+5. RULES:
+   - Objects must die before their arena does
+   - Arenas here are single-threaded (one per thread or per batch)
+   - Copy into another resource to keep an object past its arena
+
+COMPILATION:
+    g++ -std=c++17 -O2 20_Arena_Allocator.cpp -o arena && ./arena
+    ./arena 200000 5   (objects per class, rounds)
+
+NEXT STEP: Make moves cheap and getters copy-free!
+*/
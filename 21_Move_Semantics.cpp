@@ -0,0 +1,282 @@
+/*
+=============================================================
+     MOVE SEMANTICS & COPY-FREE ACCESSORS - PERFORMANCE TUTORIAL
+     File: 21_Move_Semantics.cpp
+=============================================================
+Learn: sink arguments, member-initializer lists, const& getters,
+       noexcept moves, the rule of zero, counting hidden copies
+
+main8.cpp used to build and read bikes like this:
+
+    Bike(string name, int speed, string color){
+             this->name = name;
+            this->speed = speed;
+            this->color = color;
+    }
+    string getName(){
+        return name;
+    }
+
+Every constructor call copies each string twice (argument -> parameter,
+parameter -> member) and every getName() returns a fresh copy. Sorting
+bikes by name calls getName() twice per comparison: with long names
+that is two malloc + free pairs just to compare.
+
+main8.cpp now takes the strings by value and MOVES them into the members
+in the initializer list, returns const string& from its getters, and
+has noexcept moves. This file measures the difference on 10M bikes,
+counting every heap allocation.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <chrono>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= ORIGINAL BIKE =============
+
+// main8.cpp's Bike as it was: assignment in the body, getters by value
+class BikeOriginal {
+    protected:
+        string name;
+        int speed;
+        string color;
+    public:
+        BikeOriginal(string name, int speed, string color) {
+            this->name = name;
+            this->speed = speed;
+            this->color = color;
+        }
+        string getName() {
+            return name;
+        }
+        int getSpeed() {
+            return speed;
+        }
+        string getColor() {
+            return color;
+        }
+};
+
+/*
+The same class plus an empty destructor (like the commented-out ~Bike()
+in main7.cpp). Declaring a destructor silently REMOVES the implicit move
+constructor and move assignment, so vector growth and std::sort fall
+back to copying every string.
+*/
+class BikeWithDestructor {
+    protected:
+        string name;
+        int speed;
+        string color;
+    public:
+        BikeWithDestructor(string name, int speed, string color) {
+            this->name = name;
+            this->speed = speed;
+            this->color = color;
+        }
+        ~BikeWithDestructor() {
+        }
+        string getName() {
+            return name;
+        }
+        int getSpeed() {
+            return speed;
+        }
+};
+
+// ============= REWORKED BIKE =============
+
+/*
+The reworked main8.cpp Bike:
+  - sink arguments: take by value, move into the member in the
+    initializer list. An rvalue argument is moved twice and copied
+    never; an lvalue is copied exactly once (into the parameter)
+  - const string& getters: reading copies nothing
+  - noexcept moves: vector<Bike> relocates with moves, not copies
+    (it only uses the move constructor if it cannot throw)
+*/
+class Bike {
+    protected:
+        string name;
+        int speed;
+        string color;
+    public:
+        Bike(string name, int speed, string color)
+            : name(move(name)), speed(speed), color(move(color)) {}
+
+        Bike(const Bike&) = default;
+        Bike(Bike&&) noexcept = default;
+        Bike& operator=(const Bike&) = default;
+        Bike& operator=(Bike&&) noexcept = default;
+
+        const string& getName() const { return name; }
+        int getSpeed() const { return speed; }
+        const string& getColor() const { return color; }
+};
+
+static_assert(is_nothrow_move_constructible_v<Bike>, "vector<Bike> must be able to move");
+static_assert(is_nothrow_move_constructible_v<BikeOriginal>, "implicit moves are noexcept");
+static_assert(!is_nothrow_move_constructible_v<BikeWithDestructor>, "the destructor suppresses the implicit move");
+
+// ============= ALLOCATION COUNTING =============
+
+/*
+Replacing the global operator new counts every heap allocation, which
+here is one per string copy (all names are longer than the 15-char
+small-string buffer).
+*/
+struct AllocCounter {
+    static inline size_t allocations = 0;
+};
+
+void *operator new(size_t size) {
+    AllocCounter::allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Unique, shuffled, longer than 15 chars: "Yamaha YZF-R15 #0004817"
+string bikeName(size_t i, size_t n) {
+    char buf[48];
+    size_t id = (i * 2654435761u) % n;  // 2654435761 is prime, so this shuffles 0..n-1
+    snprintf(buf, sizeof(buf), "Yamaha YZF-R15 #%07zu", id);
+    return buf;
+}
+
+// Builds n bikes (no reserve, so the vector relocates as it grows),
+// then sorts them by name through the getter
+template <typename B, typename MakeBike>
+void benchmark(const char *label, size_t n, MakeBike makeBike) {
+    vector<B> bikes;
+    size_t before = AllocCounter::allocations;
+    double buildMs = timeMs([&] {
+        for (size_t i = 0; i < n; i++) makeBike(bikes, i);
+    });
+    size_t buildAllocs = AllocCounter::allocations - before;
+
+    before = AllocCounter::allocations;
+    double sortMs = timeMs([&] {
+        sort(bikes.begin(), bikes.end(), [](B &a, B &b) { return a.getName() < b.getName(); });
+    });
+    size_t sortAllocs = AllocCounter::allocations - before;
+
+    bool sorted = is_sorted(bikes.begin(), bikes.end(), [](B &a, B &b) { return a.getName() < b.getName(); });
+    cout << "  " << label << "\n"
+         << "      build: " << buildMs << " ms, " << buildAllocs << " allocations ("
+         << double(buildAllocs) / double(n) << " per bike)\n"
+         << "      sort : " << sortMs << " ms, " << sortAllocs << " allocations"
+         << (sorted ? "" : "  NOT SORTED") << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  MOVE SEMANTICS & COPY-FREE ACCESSORS\n";
+    cout << "========================================\n";
+
+    // ===== WHAT A SINK ARGUMENT COSTS =====
+    cout << "\n--- Allocations for one Bike with a 20-char name ---\n";
+    string name = "Yamaha YZF-R15 Racer";
+    string color = "Racing Blue Metallic";
+    size_t before = AllocCounter::allocations;
+    BikeOriginal original(name, 120, color);
+    cout << "BikeOriginal(lvalues)           : " << AllocCounter::allocations - before << "\n";
+    before = AllocCounter::allocations;
+    Bike copied(name, 120, color);
+    cout << "Bike(lvalues)                   : " << AllocCounter::allocations - before << "\n";
+    before = AllocCounter::allocations;
+    Bike moved(move(name), 120, move(color));
+    cout << "Bike(move(name), move(color))   : " << AllocCounter::allocations - before << "\n";
+
+    before = AllocCounter::allocations;
+    size_t total = 0;
+    for (int i = 0; i < 1000; i++) total += original.getName().size();
+    cout << "1000 x BikeOriginal::getName()  : " << AllocCounter::allocations - before << "\n";
+    before = AllocCounter::allocations;
+    for (int i = 0; i < 1000; i++) total += moved.getName().size();
+    cout << "1000 x Bike::getName()          : " << AllocCounter::allocations - before << "\n";
+
+    // ===== BENCHMARK =====
+    // ./moves 10000000
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+
+    cout << "\n--- BENCHMARK: build and sort " << n << " bikes by name ---\n";
+    benchmark<BikeOriginal>("BikeOriginal (assign in body, getters by value)", n,
+        [n](vector<BikeOriginal> &v, size_t i) {
+            string name = bikeName(i, n);
+            v.push_back(BikeOriginal(name, int(i % 300), "Purple"));
+        });
+    benchmark<BikeWithDestructor>("BikeWithDestructor (no implicit moves)", n,
+        [n](vector<BikeWithDestructor> &v, size_t i) {
+            string name = bikeName(i, n);
+            v.push_back(BikeWithDestructor(name, int(i % 300), "Purple"));
+        });
+    benchmark<Bike>("Bike (sink + move, const& getters, noexcept moves)", n,
+        [n](vector<Bike> &v, size_t i) {
+            v.emplace_back(bikeName(i, n), int(i % 300), "Purple");
+        });
+    cout << "(checksum " << total << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. SINK ARGUMENTS:
+   - Take by value, then move into the member: T(string s) : s_(move(s))
+   - rvalue in: 0 copies; lvalue in: exactly 1 copy
+   - Assigning in the body default-constructs first, then copies
+
+2. GETTERS:
+   - const string& (or string_view) returns a view, not a new string
+   - By-value getters inside a sort comparator allocate on every compare
+
+3. noexcept MOVES:
+   - vector only moves elements on growth if the move cannot throw
+   - Declaring a destructor (even an empty one) removes the implicit moves
+   - Rule of zero: declare none of the five, or default them all
+
+4. MEASURE COPIES:
+   - Count allocations with a replaced operator new
+   - Use strings longer than the small-string buffer when testing
+
+COMPILATION:
+    g++ -std=c++17 -O2 21_Move_Semantics.cpp -o moves && ./moves
+    ./moves 1000000   (number of bikes)
+
+NEXT STEP: Intern repeated strings!
+*/
@@ -0,0 +1,516 @@
+/*
+=============================================================
+     STRING INTERNING - PERFORMANCE TUTORIAL
+     File: 22_String_Interning.cpp
+=============================================================
+Learn: interning, 4-byte symbols, arena-stored strings, sharded
+       (concurrent) hash sets, O(1) equality and hashing
+
+main8.cpp, main11.cpp and 04_Inheritance_Polymorphism.cpp keep names
+like this in every object:
+
+    Yamaha y1("BMW", 120, "Purple",6);
+    Vehicle(string b, string c, int y) : brand(b), color(c), year(y) {}
+
+There are only a handful of brands and colors, but every object owns a
+32-byte std::string for each (plus a heap block when the text is longer
+than 15 chars), and comparing two colors compares characters.
+
+Interning stores every distinct string ONCE, in a table, and gives out a
+Symbol: a 4-byte id. Same text -> same id, so:
+  - equality is one integer compare
+  - hashing is the id itself
+  - an object with two names shrinks from 64 bytes of strings to 8
+The text is still there when needed: symbol.str() returns a string_view
+into the table.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= SYMBOL TABLE =============
+
+/*
+Layout:
+  - SHARDS independent shards, picked by the top bits of the string's
+    hash. Each shard has its own mutex, so threads interning different
+    strings rarely wait on each other.
+  - Per shard: an open-addressing hash set of (hash, id) pairs, and the
+    id -> text entries.
+  - Text lives in an arena of 64 KB chunks that never move, so a
+    string_view handed out once stays valid for the life of the table.
+  - Entries live in segments of doubling size that never move either:
+    str(id) reads them without taking the lock.
+
+Id = (index inside the shard << SHARD_BITS) | shard, so str() finds the
+shard without a lookup. Id 0 (shard 0, index 0) is reserved for the
+empty string, so a default Symbol is "".
+*/
+class SymbolTable {
+    private:
+        static constexpr uint32_t SHARD_BITS = 4;
+        static constexpr uint32_t SHARDS = 1u << SHARD_BITS;
+        static constexpr size_t CHUNK_SIZE = 64 * 1024;
+        static constexpr size_t FIRST_SEGMENT = 64;
+        static constexpr size_t MAX_SEGMENTS = 22;  // 64 * (2^22 - 1) < 2^28 entries per shard
+
+        struct Entry {
+            const char *text;
+            uint32_t length;
+            uint32_t hash;
+        };
+
+        struct Slot {
+            uint32_t hash;
+            uint32_t id;  // EMPTY_SLOT when unused
+        };
+        static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+        struct alignas(64) Shard {
+            mutex lock;
+            vector<Slot> slots;
+            size_t count = 0;  // entries in this shard
+            atomic<Entry*> segments[MAX_SEGMENTS] = {};
+            vector<unique_ptr<char[]>> chunks;
+            char *cur = nullptr;
+            char *end = nullptr;
+        };
+
+        Shard shards[SHARDS];
+
+        static uint64_t hashOf(string_view s) {
+            return std::hash<string_view>()(s);
+        }
+
+        // Segment k holds FIRST_SEGMENT << k entries
+        static void locate(size_t index, size_t &segment, size_t &offset) {
+            size_t n = index / FIRST_SEGMENT + 1;
+            segment = 63 - size_t(__builtin_clzll(n));
+            offset = index - FIRST_SEGMENT * ((size_t(1) << segment) - 1);
+        }
+
+        static const char* store(Shard &shard, string_view s) {
+            if (size_t(shard.end - shard.cur) < s.size()) {
+                size_t size = max(CHUNK_SIZE, s.size());
+                shard.chunks.emplace_back(new char[size]);
+                shard.cur = shard.chunks.back().get();
+                shard.end = shard.cur + size;
+            }
+            char *text = shard.cur;
+            if (!s.empty()) memcpy(text, s.data(), s.size());
+            shard.cur += s.size();
+            return text;
+        }
+
+        const Entry& entry(uint32_t shard, size_t index) const {
+            size_t segment, offset;
+            locate(index, segment, offset);
+            return shards[shard].segments[segment].load(memory_order_acquire)[offset];
+        }
+
+        static void rehash(Shard &shard) {
+            vector<Slot> old = move(shard.slots);
+            shard.slots.assign(max<size_t>(64, old.size() * 2), Slot{0, EMPTY_SLOT});
+            size_t mask = shard.slots.size() - 1;
+            for (const Slot &slot : old) {
+                if (slot.id == EMPTY_SLOT) continue;
+                size_t pos = slot.hash & mask;
+                while (shard.slots[pos].id != EMPTY_SLOT) pos = (pos + 1) & mask;
+                shard.slots[pos] = slot;
+            }
+        }
+
+    public:
+        SymbolTable() {
+            shards[0].segments[0] = new Entry[FIRST_SEGMENT];
+            shards[0].segments[0].load()[0] = Entry{"", 0, 0};  // id 0 = ""
+            shards[0].count = 1;
+        }
+
+        ~SymbolTable() {
+            for (Shard &shard : shards)
+                for (auto &segment : shard.segments) delete[] segment.load();
+        }
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        // Returns the id of s, adding it if it is new. Thread-safe.
+        uint32_t intern(string_view s) {
+            if (s.empty()) return 0;
+            uint64_t h = hashOf(s);
+            uint32_t shardIndex = uint32_t(h >> (64 - SHARD_BITS));
+            uint32_t h32 = uint32_t(h);
+            Shard &shard = shards[shardIndex];
+
+            lock_guard<mutex> guard(shard.lock);
+            if ((shard.count + 1) * 4 > shard.slots.size() * 3) rehash(shard);
+
+            size_t mask = shard.slots.size() - 1;
+            size_t pos = h32 & mask;
+            while (shard.slots[pos].id != EMPTY_SLOT) {
+                const Slot &slot = shard.slots[pos];
+                if (slot.hash == h32) {
+                    const Entry &e = entry(shardIndex, slot.id >> SHARD_BITS);
+                    if (string_view(e.text, e.length) == s) return slot.id;
+                }
+                pos = (pos + 1) & mask;
+            }
+
+            size_t index = shard.count;
+            size_t segment, offset;
+            locate(index, segment, offset);
+            if (segment >= MAX_SEGMENTS) throw length_error("SymbolTable: too many symbols");
+            Entry *entries = shard.segments[segment].load(memory_order_relaxed);
+            if (!entries) {
+                entries = new Entry[FIRST_SEGMENT << segment];
+                shard.segments[segment].store(entries, memory_order_release);
+            }
+            entries[offset] = Entry{store(shard, s), uint32_t(s.size()), h32};
+            shard.count++;
+
+            uint32_t id = uint32_t(index << SHARD_BITS) | shardIndex;
+            shard.slots[pos] = Slot{h32, id};
+            return id;
+        }
+
+        // No lock: entries never move once written
+        string_view str(uint32_t id) const {
+            const Entry &e = entry(id & (SHARDS - 1), id >> SHARD_BITS);
+            return string_view(e.text, e.length);
+        }
+
+        size_t size() {
+            size_t total = 0;
+            for (Shard &shard : shards) {
+                lock_guard<mutex> guard(shard.lock);
+                total += shard.count;
+            }
+            return total;
+        }
+};
+
+SymbolTable& symbolTable() {
+    static SymbolTable table;
+    return table;
+}
+
+// ============= SYMBOL =============
+
+/*
+A Symbol is just the id. Construct it from text (interns it), compare
+it, hash it, print it. operator< orders by id, which is fast and stable
+but NOT alphabetical: compare str() when the order matters to people.
+*/
+class Symbol {
+    private:
+        uint32_t id_ = 0;
+
+    public:
+        Symbol() = default;
+        Symbol(string_view text) : id_(symbolTable().intern(text)) {}
+        Symbol(const char *text) : Symbol(string_view(text)) {}
+        Symbol(const string &text) : Symbol(string_view(text)) {}
+
+        string_view str() const { return symbolTable().str(id_); }
+        uint32_t id() const { return id_; }
+
+        bool operator==(Symbol other) const { return id_ == other.id_; }
+        bool operator!=(Symbol other) const { return id_ != other.id_; }
+        bool operator<(Symbol other) const { return id_ < other.id_; }
+};
+
+namespace std {
+    template <>
+    struct hash<Symbol> {
+        size_t operator()(Symbol s) const noexcept { return s.id(); }
+    };
+}
+
+ostream& operator<<(ostream &out, Symbol s) {
+    return out << s.str();
+}
+
+// ============= CLASSES WITH SYMBOLS =============
+
+// main8.cpp's Bike, and the Vehicle from 04_Inheritance_Polymorphism.cpp,
+// as they store their names today
+class BikeStrings {
+    protected:
+        string name;
+        int speed;
+        string color;
+    public:
+        BikeStrings(string name, int speed, string color)
+            : name(move(name)), speed(speed), color(move(color)) {}
+        const string& getName() const { return name; }
+        const string& getColor() const { return color; }
+        int getSpeed() const { return speed; }
+};
+
+class VehicleStrings {
+    protected:
+        string brand;
+        string color;
+        int year;
+    public:
+        VehicleStrings(string b, string c, int y) : brand(move(b)), color(move(c)), year(y) {}
+        const string& getBrand() const { return brand; }
+        const string& getColor() const { return color; }
+};
+
+// Same classes with interned names: 12 bytes instead of 72
+class Bike {
+    protected:
+        Symbol name;
+        int speed;
+        Symbol color;
+    public:
+        Bike(Symbol name, int speed, Symbol color) : name(name), speed(speed), color(color) {}
+        Symbol getName() const { return name; }
+        Symbol getColor() const { return color; }
+        int getSpeed() const { return speed; }
+};
+
+class Vehicle {
+    protected:
+        Symbol brand;
+        Symbol color;
+        int year;
+    public:
+        Vehicle(Symbol b, Symbol c, int y) : brand(b), color(c), year(y) {}
+        Symbol getBrand() const { return brand; }
+        Symbol getColor() const { return color; }
+};
+
+// ============= MEMORY ACCOUNTING =============
+
+/*
+Replacing the global operator new lets the benchmark report how many bytes
+are live. Each block gets a small header that remembers its size.
+*/
+struct AllocStats {
+    static inline atomic<size_t> current{0};
+};
+
+void *operator new(size_t size) {
+    constexpr size_t header = alignof(max_align_t);
+    void *raw = malloc(size + header);
+    if (!raw) throw bad_alloc();
+    *static_cast<size_t*>(raw) = size;
+    AllocStats::current += size;
+    return static_cast<char*>(raw) + header;
+}
+
+void operator delete(void *p) noexcept {
+    if (!p) return;
+    constexpr size_t header = alignof(max_align_t);
+    void *raw = static_cast<char*>(p) - header;
+    AllocStats::current -= *static_cast<size_t*>(raw);
+    free(raw);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    operator delete(p);
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+double toMB(size_t bytes) {
+    return double(bytes) / (1024.0 * 1024.0);
+}
+
+// A few brands and colors, some longer than the 15-char small-string buffer,
+// and 1000 model names
+struct Catalog {
+    vector<string> colors = {"Purple", "Black", "Racing Blue Metallic", "Midnight Purple Metallic",
+                             "Pearl White", "Candy Red Lacquer Finish", "Matte Graphite Grey"};
+    vector<string> models;
+
+    Catalog() {
+        const char *brands[] = {"BMW", "Honda", "Yamaha", "Kawasaki Heavy Industries", "Ducati Motor Holding"};
+        for (int i = 0; i < 1000; i++) models.push_back(string(brands[i % 5]) + " Series " + to_string(i));
+    }
+};
+
+void benchmark(size_t n) {
+    Catalog catalog;
+    cout << "\n--- BENCHMARK: " << n << " bikes (1000 names, 7 colors) ---\n";
+
+    size_t pick = 0;
+    auto nextIndex = [&pick](size_t range) {
+        pick = pick * 6364136223846793005ULL + 1442695040888963407ULL;
+        return size_t(pick >> 33) % range;
+    };
+
+    long long matches1 = 0, matches2 = 0;
+    size_t groups1 = 0, groups2 = 0;
+    double build1, build2, filter1, filter2, group1, group2;
+    size_t bytes1, bytes2;
+
+    {
+        size_t before = AllocStats::current;
+        vector<BikeStrings> bikes;
+        bikes.reserve(n);
+        pick = 1;
+        build1 = timeMs([&] {
+            for (size_t i = 0; i < n; i++) {
+                bikes.emplace_back(catalog.models[nextIndex(1000)], int(i % 300), catalog.colors[nextIndex(7)]);
+            }
+        });
+        bytes1 = AllocStats::current - before;
+
+        string wanted = "Midnight Purple Metallic";
+        filter1 = timeMs([&] {
+            for (const BikeStrings &b : bikes) matches1 += b.getColor() == wanted;
+        });
+        group1 = timeMs([&] {
+            unordered_map<string, int> perName;
+            for (const BikeStrings &b : bikes) perName[b.getName()]++;
+            groups1 = perName.size();
+        });
+    }
+    {
+        size_t before = AllocStats::current;
+        vector<Bike> bikes;
+        bikes.reserve(n);
+        pick = 1;
+        build2 = timeMs([&] {
+            for (size_t i = 0; i < n; i++) {
+                bikes.emplace_back(catalog.models[nextIndex(1000)], int(i % 300), catalog.colors[nextIndex(7)]);
+            }
+        });
+        bytes2 = AllocStats::current - before;  // includes the symbol table's growth
+
+        Symbol wanted = "Midnight Purple Metallic";
+        filter2 = timeMs([&] {
+            for (const Bike &b : bikes) matches2 += b.getColor() == wanted;
+        });
+        group2 = timeMs([&] {
+            unordered_map<Symbol, int> perName;
+            for (const Bike &b : bikes) perName[b.getName()]++;
+            groups2 = perName.size();
+        });
+    }
+
+    cout << "  sizeof(BikeStrings) = " << sizeof(BikeStrings) << ", sizeof(Bike) = " << sizeof(Bike) << "\n";
+    cout << "  memory : string members " << toMB(bytes1) << " MB, symbols " << toMB(bytes2) << " MB ("
+         << double(bytes1) / double(n) << " vs " << double(bytes2) / double(n) << " bytes per bike)\n";
+    cout << "  build  : string members " << build1 << " ms, symbols " << build2 << " ms\n";
+    cout << "  filter : string compare " << filter1 << " ms, id compare " << filter2 << " ms"
+         << " (" << matches1 << " / " << matches2 << " matches)\n";
+    cout << "  group  : unordered_map<string> " << group1 << " ms, unordered_map<Symbol> " << group2 << " ms"
+         << " (" << groups1 << " / " << groups2 << " groups)\n";
+
+    // Worst case for interning: every name is new and the table only grows
+    size_t before = AllocStats::current;
+    size_t fresh = min<size_t>(n, 1000000);
+    double internMs = timeMs([&] {
+        for (size_t i = 0; i < fresh; i++) Symbol("unique bike name #" + to_string(i));
+    });
+    cout << "  intern " << fresh << " NEW strings: " << internMs << " ms, table grew by "
+         << toMB(AllocStats::current - before) << " MB\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  STRING INTERNING\n";
+    cout << "========================================\n";
+
+    // ===== SYMBOLS =====
+    cout << "\n--- Symbols ---\n";
+    Symbol purple = "Purple";
+    Symbol purpleAgain = string("Pur") + "ple";
+    Symbol bmw = "BMW";
+    cout << purple << " == " << purpleAgain << ": " << boolalpha << (purple == purpleAgain)
+         << " (id " << purple.id() << ")\n";
+    cout << purple << " == " << bmw << ": " << (purple == bmw) << "\n";
+    cout << "sizeof(Symbol) = " << sizeof(Symbol) << ", sizeof(string) = " << sizeof(string) << "\n";
+
+    Bike y1("BMW", 120, "Purple");  // main8.cpp: Yamaha y1("BMW", 120, "Purple",6)
+    Vehicle v1("Honda", "Black", 2022);
+    cout << y1.getName() << " / " << y1.getColor() << ", " << v1.getBrand() << " / " << v1.getColor() << "\n";
+
+    // ===== CONCURRENT INTERNING =====
+    cout << "\n--- Interning from 4 threads ---\n";
+    vector<vector<uint32_t>> ids(4);
+    vector<thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([t, &ids] {
+            for (int i = 0; i < 10000; i++) ids[t].push_back(Symbol("model-" + to_string((i * 7 + t) % 5000)).id());
+        });
+    }
+    for (thread &w : workers) w.join();
+    bool consistent = true;
+    for (int t = 0; t < 4; t++) {
+        for (int i = 0; i < 10000; i++) {
+            consistent &= symbolTable().str(ids[t][i]) == "model-" + to_string((i * 7 + t) % 5000);
+        }
+    }
+    cout << "every thread got the right symbols: " << consistent
+         << ", table holds " << symbolTable().size() << " strings\n";
+
+    // ===== BENCHMARK =====
+    // ./intern 10000000
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    benchmark(n);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. INTERNING:
+   - Store each distinct string once, refer to it by a small id
+   - Same text -> same id, so == is one integer compare
+   - hash(symbol) = id: no hashing of characters after the first intern
+
+2. STABLE STORAGE:
+   - Text in arena chunks that never move (string_views stay valid)
+   - Id -> text entries in doubling segments: lock-free reads
+
+3. CONCURRENCY BY SHARDING:
+   - The hash picks one of 16 shards, each with its own mutex
+   - Different strings rarely contend for the same lock
+
+4. TRADE-OFFS:
+   - Interning a NEW string costs a hash + lock + copy
+   - Strings are never freed (fine for names, colors, keywords)
+   - Ids are not alphabetical: sort by str() for display order
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 22_String_Interning.cpp -o intern && ./intern
+    ./intern 1000000   (number of bikes)
+
+NEXT STEP: Call virtual functions without the virtual call!
+*/
@@ -0,0 +1,338 @@
+/*
+=============================================================
+     DEVIRTUALIZED BATCH DISPATCH - PERFORMANCE TUTORIAL
+     File: 23_Devirtualized_Dispatch.cpp
+=============================================================
+Learn: cost of virtual calls, type-partitioned storage, final classes,
+       static dispatch with templates and fold expressions
+
+main11.cpp rides bikes through base-class pointers:
+
+    Bike *bikes[3];
+    bikes[0] = &bmw;
+    bikes[1] = &honda;
+    bikes[2] = &yamaha;
+    for (int i = 0; i < 3; i++) {
+        rideTheBike(bikes[i]);    // bike->go(); bike->stop();
+    }
+
+For 3 bikes that is perfect. For millions of bikes per tick, each call
+  - loads the object's vtable pointer, then the function address
+  - jumps indirectly: the CPU has to guess the target, and with mixed
+    types in random order it guesses wrong often
+  - cannot be inlined, so the compiler cannot vectorize the loop
+and every object is its own heap allocation, somewhere in memory.
+
+BikeCollection<BMW, Honda, Yamaha> keeps one contiguous vector PER TYPE.
+for_each_bike(f) walks the BMW array, then the Honda array, then the
+Yamaha array. Inside each loop the type is known at compile time, so
+go()/stop() are direct calls that get inlined. Same classes, same
+virtual interface for code that still needs it.
+*/
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <typeinfo>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= BIKE INTERFACE =============
+
+/*
+main11.cpp's interface. go()/stop() update the bike's state instead of
+printing, so the loop does a little real work per call (a simulation
+tick), like a game or traffic model would.
+
+Integer state keeps the results exactly comparable between the loops.
+*/
+class Bike {
+    public:
+        virtual void go() = 0;
+        virtual void stop() = 0;
+        virtual long long position() const = 0;
+        virtual ~Bike() {}
+};
+
+// final: no class can override go() again, so a call on a BMW& (not a
+// Bike&) is known to be BMW::go() and can be inlined
+class BMW final : public Bike {
+    private:
+        int speed = 0;
+        long long pos = 0;
+    public:
+        void go() override {
+            speed = min(speed + 5, 300);
+            pos += speed;
+        }
+        void stop() override {
+            speed -= speed / 4;
+        }
+        long long position() const override { return pos; }
+};
+
+class Honda final : public Bike {
+    private:
+        int speed = 0;
+        long long pos = 0;
+    public:
+        void go() override {
+            speed = min(speed + 3, 180);
+            pos += speed;
+        }
+        void stop() override {
+            speed -= speed / 8;
+        }
+        long long position() const override { return pos; }
+};
+
+class Yamaha final : public Bike {
+    private:
+        int speed = 0;
+        long long pos = 0;
+    public:
+        void go() override {
+            speed = min(speed + 4, 250);
+            pos += speed;
+        }
+        void stop() override {
+            speed -= speed / 2;
+        }
+        long long position() const override { return pos; }
+};
+
+// The loop body from main11.cpp, without the printing
+void rideTheBike(Bike *bike) {
+    bike->go();
+    bike->stop();
+}
+
+// ============= TYPE-PARTITIONED COLLECTION =============
+
+/*
+One vector per type, held in a tuple:
+
+    tuple<vector<BMW>, vector<Honda>, vector<Yamaha>>
+
+emplace<T>(...) appends to vector<T>. for_each_bike(f) expands over the
+tuple with a fold expression; f is a generic lambda, instantiated once
+per type, so inside each instantiation "bike.go()" is a direct call.
+
+Order between types is lost (all BMWs come first). That is fine for
+per-object updates like a simulation tick; code that needs the original
+order should keep ids or use a different structure.
+*/
+template <typename... Types>
+class BikeCollection {
+    static_assert((is_final_v<Types> && ...), "use final classes so calls can be devirtualized");
+
+    private:
+        tuple<vector<Types>...> arrays;
+
+    public:
+        template <typename T, typename... Args>
+        T& emplace(Args&&... args) {
+            return get<vector<T>>(arrays).emplace_back(forward<Args>(args)...);
+        }
+
+        template <typename T>
+        vector<T>& all() {
+            return get<vector<T>>(arrays);
+        }
+
+        // Calls f(bike) for every bike, one type at a time, with the static type
+        template <typename Func>
+        void for_each_bike(Func f) {
+            apply([&](auto&... vectors) {
+                (for_each_in(vectors, f), ...);
+            }, arrays);
+        }
+
+        template <typename Func>
+        void for_each_bike(Func f) const {
+            apply([&](const auto&... vectors) {
+                (for_each_in(vectors, f), ...);
+            }, arrays);
+        }
+
+        size_t size() const {
+            return apply([](const auto&... vectors) { return (vectors.size() + ...); }, arrays);
+        }
+
+        void reserve(size_t perType) {
+            apply([perType](auto&... vectors) { (vectors.reserve(perType), ...); }, arrays);
+        }
+
+    private:
+        template <typename Vector, typename Func>
+        static void for_each_in(Vector &bikes, Func &f) {
+            for (auto &bike : bikes) f(bike);
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void benchmark(size_t n, int ticks) {
+    cout << "\n--- BENCHMARK: " << n << " bikes (random mix), " << ticks << " ticks ---\n";
+
+    // A random type for every bike
+    mt19937 rng(42);
+    vector<int> kinds(n);
+    for (size_t i = 0; i < n; i++) kinds[i] = int(rng() % 3);
+
+    // 1. main11.cpp style: each bike its own heap object, called through Bike*
+    vector<unique_ptr<Bike>> pointers;
+    pointers.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (kinds[i] == 0) pointers.push_back(make_unique<BMW>());
+        else if (kinds[i] == 1) pointers.push_back(make_unique<Honda>());
+        else pointers.push_back(make_unique<Yamaha>());
+    }
+    // Objects created over time end up scattered; shuffle to model that
+    shuffle(pointers.begin(), pointers.end(), rng);
+
+    double virtualMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++)
+            for (auto &bike : pointers) rideTheBike(bike.get());
+    });
+    long long virtualSum = 0;
+    for (auto &bike : pointers) virtualSum += bike->position();
+
+    // 2. Same pointers, sorted by type: the indirect branch becomes predictable
+    vector<unique_ptr<Bike>> sortedPointers;
+    sortedPointers.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (kinds[i] == 0) sortedPointers.push_back(make_unique<BMW>());
+        else if (kinds[i] == 1) sortedPointers.push_back(make_unique<Honda>());
+        else sortedPointers.push_back(make_unique<Yamaha>());
+    }
+    stable_sort(sortedPointers.begin(), sortedPointers.end(), [](const auto &a, const auto &b) {
+        return typeid(*a).before(typeid(*b));
+    });
+    double sortedMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++)
+            for (auto &bike : sortedPointers) rideTheBike(bike.get());
+    });
+    long long sortedSum = 0;
+    for (auto &bike : sortedPointers) sortedSum += bike->position();
+
+    // 3. Type-partitioned arrays, static dispatch
+    BikeCollection<BMW, Honda, Yamaha> collection;
+    collection.reserve(n / 3 + 1);
+    for (size_t i = 0; i < n; i++) {
+        if (kinds[i] == 0) collection.emplace<BMW>();
+        else if (kinds[i] == 1) collection.emplace<Honda>();
+        else collection.emplace<Yamaha>();
+    }
+    double staticMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++) {
+            collection.for_each_bike([](auto &bike) {
+                bike.go();
+                bike.stop();
+            });
+        }
+    });
+    long long staticSum = 0;
+    collection.for_each_bike([&](const auto &bike) { staticSum += bike.position(); });
+
+    double calls = double(n) * ticks * 2;
+    cout << "  virtual, Bike* array (random order): " << virtualMs << " ms, "
+         << virtualMs * 1e6 / calls << " ns/call\n";
+    cout << "  virtual, Bike* array sorted by type: " << sortedMs << " ms, "
+         << sortedMs * 1e6 / calls << " ns/call\n";
+    cout << "  BikeCollection::for_each_bike      : " << staticMs << " ms, "
+         << staticMs * 1e6 / calls << " ns/call\n";
+    cout << "  positions match: " << boolalpha
+         << (virtualSum == staticSum && sortedSum == staticSum) << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  DEVIRTUALIZED BATCH DISPATCH\n";
+    cout << "========================================\n";
+
+    // ===== THE COLLECTION =====
+    cout << "\n--- BikeCollection ---\n";
+    BikeCollection<BMW, Honda, Yamaha> garage;
+    garage.emplace<BMW>();
+    garage.emplace<Honda>();
+    garage.emplace<Yamaha>();
+    garage.emplace<Yamaha>();
+    for (int t = 0; t < 3; t++) {
+        garage.for_each_bike([](auto &bike) {
+            bike.go();
+            bike.stop();
+        });
+    }
+    cout << garage.size() << " bikes, " << garage.all<Yamaha>().size() << " of them Yamahas\n";
+    garage.for_each_bike([](const auto &bike) {
+        cout << "  " << bike.position() << "\n";
+    });
+
+    // Code that needs the virtual interface can still take a Bike&
+    Bike &first = garage.all<BMW>().front();
+    rideTheBike(&first);
+    cout << "BMW after one more ride through Bike*: " << first.position() << "\n";
+
+    // ===== BENCHMARK =====
+    // ./dispatch 3000000 20
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 3000000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 20;
+    benchmark(n, ticks);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. WHAT A VIRTUAL CALL COSTS:
+   - Load vptr, load function pointer, indirect jump
+   - Mispredicted when types arrive in random order
+   - No inlining, so no vectorization of the loop around it
+
+2. SORT BY TYPE:
+   - Same virtual calls, but the branch predictor now guesses right
+   - Objects are still scattered heap allocations
+
+3. TYPE-PARTITIONED STORAGE:
+   - One contiguous vector per concrete type
+   - Loop over each vector with the static type known
+   - final classes: the compiler may call (and inline) T::go() directly
+
+4. TEMPLATE MACHINERY:
+   - tuple<vector<Types>...> holds the arrays
+   - apply + fold expression visits every array
+   - A generic lambda is instantiated once per type
+
+5. TRADE-OFFS:
+   - Order between types is not preserved
+   - The set of types is fixed at compile time
+   - Objects still carry a vptr if they keep the virtual interface
+
+COMPILATION:
+    g++ -std=c++17 -O2 23_Devirtualized_Dispatch.cpp -o dispatch && ./dispatch
+    ./dispatch 3000000 20   (bikes, ticks)
+
+NEXT STEP: Replace the class hierarchy with std::variant!
+*/
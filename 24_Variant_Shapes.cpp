@@ -0,0 +1,389 @@
+/*
+=============================================================
+     VARIANT SHAPES - PERFORMANCE TUTORIAL
+     File: 24_Variant_Shapes.cpp
+=============================================================
+Learn: closed hierarchies with std::variant, std::visit, tagged unions,
+       value semantics, contiguous storage without per-object new
+
+04_Inheritance_Polymorphism.cpp models shapes as a class hierarchy:
+
+    class Shape { ... virtual void draw() = 0; ... };
+    class Circle : public Shape { double radius; ... double getArea() ... };
+    class Rectangle : public Shape { double width, height; ... };
+
+To keep a mixed list you need Shape* (usually one new per shape), and
+every call goes through a vtable. For a hot loop over millions of shapes
+that means one heap object and one indirect call per shape.
+
+When the set of shapes is CLOSED (we know every kind up front), a
+variant does the same job by value:
+
+    using Shape = variant<Circle, Rectangle>;
+    vector<Shape> shapes;      // one contiguous block, no new per shape
+
+visit() picks the right function with a switch on the stored index, and
+the functions can be inlined. This file also shows the same idea written
+by hand (TaggedShape: an enum tag + a union), which is what variant does
+underneath.
+*/
+
+#include <iostream>
+#include <vector>
+#include <variant>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+constexpr double PI = 3.14159265358979323846;
+
+// ============= VALUE SHAPES =============
+
+/*
+Plain structs: no base class, no vptr, no heap. The color from 04 is a
+packed RGB value, so a shape is all numbers and trivially copyable.
+*/
+struct BoundingBox {
+    double minX, minY, maxX, maxY;
+
+    void expand(const BoundingBox &other) {
+        minX = min(minX, other.minX);
+        minY = min(minY, other.minY);
+        maxX = max(maxX, other.maxX);
+        maxY = max(maxY, other.maxY);
+    }
+};
+
+struct Circle {
+    double x, y;  // center
+    double radius;
+    uint32_t color;
+};
+
+struct Rectangle {
+    double x, y;  // lower-left corner
+    double width, height;
+    uint32_t color;
+};
+
+double area(const Circle &c) { return PI * c.radius * c.radius; }
+double area(const Rectangle &r) { return r.width * r.height; }
+
+double perimeter(const Circle &c) { return 2 * PI * c.radius; }
+double perimeter(const Rectangle &r) { return 2 * (r.width + r.height); }
+
+BoundingBox bounds(const Circle &c) {
+    return {c.x - c.radius, c.y - c.radius, c.x + c.radius, c.y + c.radius};
+}
+BoundingBox bounds(const Rectangle &r) {
+    return {r.x, r.y, r.x + r.width, r.y + r.height};
+}
+
+// ============= VARIANT SHAPE =============
+
+using Shape = variant<Circle, Rectangle>;
+
+// visit() calls the overload for whichever type the variant holds
+double area(const Shape &s) {
+    return visit([](const auto &shape) { return area(shape); }, s);
+}
+
+double perimeter(const Shape &s) {
+    return visit([](const auto &shape) { return perimeter(shape); }, s);
+}
+
+BoundingBox bounds(const Shape &s) {
+    return visit([](const auto &shape) { return bounds(shape); }, s);
+}
+
+// Builds one visitor out of several lambdas (the usual C++17 helper)
+template <typename... Lambdas>
+struct overloaded : Lambdas... {
+    using Lambdas::operator()...;
+};
+template <typename... Lambdas>
+overloaded(Lambdas...) -> overloaded<Lambdas...>;
+
+// ============= TAGGED UNION =============
+
+/*
+What variant does, by hand: a tag saying which member of the union is
+live, and a switch on it. Same size and speed as the variant here; the
+hand-written version has no "valueless" state to check (a variant can
+end up empty if an assignment throws) and its layout is fully yours,
+e.g. to squeeze the tag into spare bits.
+*/
+class TaggedShape {
+    public:
+        enum class Kind : uint32_t { Circle, Rectangle };
+
+    private:
+        union {
+            Circle circle;
+            Rectangle rect;
+        };
+        Kind kind;
+
+    public:
+        TaggedShape(const Circle &c) : circle(c), kind(Kind::Circle) {}
+        TaggedShape(const Rectangle &r) : rect(r), kind(Kind::Rectangle) {}
+
+        Kind getKind() const { return kind; }
+
+        double area() const {
+            switch (kind) {
+                case Kind::Circle: return ::area(circle);
+                case Kind::Rectangle: return ::area(rect);
+            }
+            return 0;
+        }
+
+        double perimeter() const {
+            switch (kind) {
+                case Kind::Circle: return ::perimeter(circle);
+                case Kind::Rectangle: return ::perimeter(rect);
+            }
+            return 0;
+        }
+
+        BoundingBox bounds() const {
+            switch (kind) {
+                case Kind::Circle: return ::bounds(circle);
+                case Kind::Rectangle: return ::bounds(rect);
+            }
+            return {};
+        }
+};
+
+// ============= VIRTUAL SHAPES =============
+
+// The 04_Inheritance_Polymorphism.cpp design with the same geometry
+class ShapeVirtual {
+    protected:
+        uint32_t color;
+    public:
+        explicit ShapeVirtual(uint32_t c) : color(c) {}
+        virtual double getArea() const = 0;
+        virtual double getPerimeter() const = 0;
+        virtual BoundingBox getBounds() const = 0;
+        virtual ~ShapeVirtual() {}
+};
+
+class CircleVirtual : public ShapeVirtual {
+    private:
+        double x, y, radius;
+    public:
+        explicit CircleVirtual(const Circle &c) : ShapeVirtual(c.color), x(c.x), y(c.y), radius(c.radius) {}
+        double getArea() const override { return PI * radius * radius; }
+        double getPerimeter() const override { return 2 * PI * radius; }
+        BoundingBox getBounds() const override { return {x - radius, y - radius, x + radius, y + radius}; }
+};
+
+class RectangleVirtual : public ShapeVirtual {
+    private:
+        double x, y, width, height;
+    public:
+        explicit RectangleVirtual(const Rectangle &r)
+            : ShapeVirtual(r.color), x(r.x), y(r.y), width(r.width), height(r.height) {}
+        double getArea() const override { return width * height; }
+        double getPerimeter() const override { return 2 * (width + height); }
+        BoundingBox getBounds() const override { return {x, y, x + width, y + height}; }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+struct Totals {
+    double area = 0;
+    double perimeter = 0;
+    BoundingBox box = {1e300, 1e300, -1e300, -1e300};
+
+    bool operator==(const Totals &o) const {
+        return area == o.area && perimeter == o.perimeter && box.minX == o.box.minX &&
+               box.minY == o.box.minY && box.maxX == o.box.maxX && box.maxY == o.box.maxY;
+    }
+};
+
+void benchmark(size_t n, int reps) {
+    cout << "\n--- BENCHMARK: " << n << " mixed shapes, " << reps << " passes ---\n";
+
+    mt19937_64 rng(7);
+    uniform_real_distribution<double> coord(-1000, 1000), size(0.5, 20);
+    vector<Shape> shapes;
+    shapes.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (rng() % 2) shapes.push_back(Circle{coord(rng), coord(rng), size(rng), 0xFF0000});
+        else shapes.push_back(Rectangle{coord(rng), coord(rng), size(rng), size(rng), 0x000000});
+    }
+
+    vector<TaggedShape> tagged;
+    tagged.reserve(n);
+    for (const Shape &s : shapes) visit([&](const auto &shape) { tagged.emplace_back(shape); }, s);
+
+    // One new per shape, made in random order so neighbours in the vector
+    // are not neighbours in memory (as after a long-running program's churn)
+    vector<unique_ptr<ShapeVirtual>> pointers(n);
+    vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    shuffle(order.begin(), order.end(), rng);
+    for (size_t i : order) {
+        visit(overloaded{
+            [&](const Circle &c) { pointers[i] = make_unique<CircleVirtual>(c); },
+            [&](const Rectangle &r) { pointers[i] = make_unique<RectangleVirtual>(r); },
+        }, shapes[i]);
+    }
+
+    Totals virtualTotals, variantTotals, taggedTotals;
+    double virtualMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            Totals t;
+            for (const auto &s : pointers) {
+                t.area += s->getArea();
+                t.perimeter += s->getPerimeter();
+                t.box.expand(s->getBounds());
+            }
+            virtualTotals = t;
+        }
+    });
+    double variantMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            Totals t;
+            for (const Shape &s : shapes) {
+                t.area += area(s);
+                t.perimeter += perimeter(s);
+                t.box.expand(bounds(s));
+            }
+            variantTotals = t;
+        }
+    });
+    double taggedMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            Totals t;
+            for (const TaggedShape &s : tagged) {
+                t.area += s.area();
+                t.perimeter += s.perimeter();
+                t.box.expand(s.bounds());
+            }
+            taggedTotals = t;
+        }
+    });
+
+    // Area only: the reduction the hot loop needs most
+    double areaVirtual = 0, areaVariant = 0;
+    double areaVirtualMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            double sum = 0;
+            for (const auto &s : pointers) sum += s->getArea();
+            areaVirtual = sum;
+        }
+    });
+    double areaVariantMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            double sum = 0;
+            for (const Shape &s : shapes) sum += area(s);
+            areaVariant = sum;
+        }
+    });
+
+    cout << "  bytes per shape: virtual " << sizeof(unique_ptr<ShapeVirtual>) << " + "
+         << sizeof(RectangleVirtual) << " (heap), variant " << sizeof(Shape)
+         << ", tagged union " << sizeof(TaggedShape) << "\n";
+    cout << "  area + perimeter + bounds:\n";
+    cout << "    virtual (Shape* array): " << virtualMs / reps << " ms/pass\n";
+    cout << "    variant + visit       : " << variantMs / reps << " ms/pass\n";
+    cout << "    tagged union + switch : " << taggedMs / reps << " ms/pass\n";
+    cout << "  area only:\n";
+    cout << "    virtual (Shape* array): " << areaVirtualMs / reps << " ms/pass\n";
+    cout << "    variant + visit       : " << areaVariantMs / reps << " ms/pass\n";
+    cout << "  total area " << variantTotals.area << ", results match: " << boolalpha
+         << (virtualTotals == variantTotals && taggedTotals == variantTotals && areaVirtual == areaVariant) << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  VARIANT SHAPES\n";
+    cout << "========================================\n";
+
+    // ===== SHAPES BY VALUE =====
+    cout << "\n--- vector<variant<Circle, Rectangle>> ---\n";
+    vector<Shape> shapes = {
+        Circle{0, 0, 5, 0xFF0000},           // 04: Circle("Red", 5)
+        Rectangle{0, 0, 4, 6, 0x0000FF},     // 04: Rectangle("Blue", 4, 6)
+        Circle{10, 10, 1, 0x00FF00},
+    };
+    for (const Shape &s : shapes) {
+        BoundingBox b = bounds(s);
+        cout << (holds_alternative<Circle>(s) ? "circle   " : "rectangle")
+             << " area " << area(s) << ", perimeter " << perimeter(s)
+             << ", box (" << b.minX << ", " << b.minY << ") - (" << b.maxX << ", " << b.maxY << ")\n";
+    }
+
+    // Several lambdas in one visitor, like the draw() overrides in 04
+    for (const Shape &s : shapes) {
+        visit(overloaded{
+            [](const Circle &c) { cout << "Drawing a circle with radius: " << c.radius << "\n"; },
+            [](const Rectangle &r) { cout << "Drawing a rectangle " << r.width << "x" << r.height << "\n"; },
+        }, s);
+    }
+
+    // Value semantics: copying a shape copies the shape, no slicing, no clone()
+    Shape copy = shapes[1];
+    get<Rectangle>(copy).width = 100;
+    cout << "copy area " << area(copy) << ", original still " << area(shapes[1]) << "\n";
+
+    // ===== BENCHMARK =====
+    // ./shapes 10000000 5
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    int reps = argc > 2 ? atoi(argv[2]) : 5;
+    benchmark(n, reps);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. CLOSED vs OPEN HIERARCHIES:
+   - Virtual functions: anyone can add a new Shape later (open)
+   - variant: the list of shapes is fixed, adding an operation is easy (closed)
+
+2. VALUE SEMANTICS:
+   - vector<variant<...>>: one contiguous block, no new per shape
+   - Copies are real copies: no slicing, no clone()
+
+3. std::visit:
+   - Switches on the stored index, calls the matching overload
+   - Generic lambda or an overloaded{...} set of lambdas
+   - The called functions can be inlined
+
+4. TAGGED UNION:
+   - enum tag + union + switch: what variant does underneath
+   - Full control of the layout; no valueless state
+
+5. WHEN TO PICK WHICH:
+   - Hot loops over many small objects of a few known kinds: variant
+   - Plugins, unknown types, big objects: virtual functions
+
+COMPILATION:
+    g++ -std=c++17 -O2 24_Variant_Shapes.cpp -o shapes && ./shapes
+    ./shapes 10000000 5   (shapes, passes)
+
+NEXT STEP: Store shapes as structure of arrays!
+*/
@@ -0,0 +1,810 @@
+/*
+=============================================================
+     STRUCTURE-OF-ARRAYS SHAPE STORE - PERFORMANCE TUTORIAL
+     File: 25_SoA_Shape_Store.cpp
+=============================================================
+Learn: array-of-structs vs struct-of-arrays, aligned column storage,
+       AVX2 batch kernels (math, masked sums, filters), runtime dispatch
+
+04_Inheritance_Polymorphism.cpp computes areas one object at a time:
+
+    class Circle : public Shape {      // Shape holds: string color;
+        double radius;
+        double getArea() {
+            return 3.14159 * radius * radius;
+        }
+    };
+
+A Circle object is a vptr, a 32-byte string and one double. Summing the
+areas of a million circles drags all of that through the cache to use 8
+bytes of each object, and the loop handles one radius per step.
+
+ShapeStore turns it around (structure of arrays):
+
+    circles:     radius[]  color[]
+    rectangles:  width[]   height[]  color[]
+
+Every column is one 64-byte aligned array, colors are 4-byte ids from a
+small intern table, and each kernel streams exactly the columns it
+needs, 4 doubles (AVX2) per instruction. Scalar versions of every kernel
+are the fallback, and both are checked against the per-object methods.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SHAPES_HAVE_X86 1
+#endif
+using namespace std;
+
+// The constant 04_Inheritance_Polymorphism.cpp uses, so results match exactly
+constexpr double PI = 3.14159;
+
+// ============= PER-OBJECT SHAPES =============
+
+// The 04 classes (draw/describe left out), plus getPerimeter for validation
+class Shape {
+    protected:
+        string color;
+    public:
+        Shape(string c) : color(c) {}
+        const string& getColor() const { return color; }
+        virtual ~Shape() {}
+};
+
+class Circle : public Shape {
+    private:
+        double radius;
+    public:
+        Circle(string c, double r) : Shape(c), radius(r) {}
+        double getArea() const { return 3.14159 * radius * radius; }
+        double getPerimeter() const { return 2 * 3.14159 * radius; }
+        double getRadius() const { return radius; }
+};
+
+class Rectangle : public Shape {
+    private:
+        double width, height;
+    public:
+        Rectangle(string c, double w, double h) : Shape(c), width(w), height(h) {}
+        double getArea() const { return width * height; }
+        double getPerimeter() const { return 2 * (width + height); }
+        double getWidth() const { return width; }
+        double getHeight() const { return height; }
+};
+
+// ============= SCALAR KERNELS =============
+
+/*
+Each kernel works on raw column pointers. The scalar versions are the
+reference and the fallback for CPUs without AVX2.
+*/
+void circleAreaScalar(const double *r, size_t n, double *out) {
+    for (size_t i = 0; i < n; i++) out[i] = PI * r[i] * r[i];
+}
+
+void rectAreaScalar(const double *w, const double *h, size_t n, double *out) {
+    for (size_t i = 0; i < n; i++) out[i] = w[i] * h[i];
+}
+
+void circlePerimeterScalar(const double *r, size_t n, double *out) {
+    for (size_t i = 0; i < n; i++) out[i] = 2 * PI * r[i];
+}
+
+void rectPerimeterScalar(const double *w, const double *h, size_t n, double *out) {
+    for (size_t i = 0; i < n; i++) out[i] = 2 * (w[i] + h[i]);
+}
+
+// Sum of areas of the shapes whose color is `color`
+double circleAreaForColorScalar(const double *r, const uint32_t *colors, size_t n, uint32_t color) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (colors[i] == color) sum += PI * r[i] * r[i];
+    }
+    return sum;
+}
+
+double rectAreaForColorScalar(const double *w, const double *h, const uint32_t *colors, size_t n, uint32_t color) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (colors[i] == color) sum += w[i] * h[i];
+    }
+    return sum;
+}
+
+double circleAreaSumScalar(const double *r, size_t n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) sum += PI * r[i] * r[i];
+    return sum;
+}
+
+double rectAreaSumScalar(const double *w, const double *h, size_t n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) sum += w[i] * h[i];
+    return sum;
+}
+
+/*
+Adds the area of every shape to the bin of its color, in one pass. There
+are four copies of the bins (copy i % 4 for shape i): two neighbours with
+the same color then add to different memory, so the adds do not wait for
+each other. bins holds 4 * colorCount zeroed doubles; the caller adds
+the copies together.
+*/
+void circleAreaByColorScalar(const double *r, const uint32_t *colors, size_t n, double *bins, size_t colorCount) {
+    for (size_t i = 0; i < n; i++) bins[(i & 3) * colorCount + colors[i]] += PI * r[i] * r[i];
+}
+
+void rectAreaByColorScalar(const double *w, const double *h, const uint32_t *colors, size_t n,
+                           double *bins, size_t colorCount) {
+    for (size_t i = 0; i < n; i++) bins[(i & 3) * colorCount + colors[i]] += w[i] * h[i];
+}
+
+// Writes the indices i with colors[i] == color, returns how many
+size_t filterColorScalar(const uint32_t *colors, size_t n, uint32_t color, uint32_t *out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (colors[i] == color) out[count++] = uint32_t(i);
+    }
+    return count;
+}
+
+// ============= AVX2 KERNELS =============
+
+#ifdef SHAPES_HAVE_X86
+/*
+4 doubles per register. The arithmetic is done in the same order as the
+scalar code (PI * r, then * r) and there is no FMA, so per-shape results
+are bit-identical; only the sums are added in a different order.
+
+Masked sums: compare 4 color ids (32-bit) at once, widen the 0/-1 lanes
+to 64 bits, and AND the areas with the mask, so shapes of other colors
+add 0. No branch per shape.
+
+Filter: compare 8 ids, movemask gives one bit per match, and the set
+bits become indices.
+*/
+__attribute__((target("avx2"))) inline double horizontalSum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2"))) inline __m256d colorMask(const uint32_t *colors, __m128i wanted) {
+    __m128i ids = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors));
+    return _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(ids, wanted)));
+}
+
+__attribute__((target("avx2")))
+void circleAreaAVX2(const double *r, size_t n, double *out) {
+    const __m256d pi = _mm256_set1_pd(PI);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(r + i);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_mul_pd(pi, x), x));
+    }
+    circleAreaScalar(r + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void rectAreaAVX2(const double *w, const double *h, size_t n, double *out) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i)));
+    }
+    rectAreaScalar(w + i, h + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void circlePerimeterAVX2(const double *r, size_t n, double *out) {
+    const __m256d twoPi = _mm256_set1_pd(2 * PI);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(twoPi, _mm256_loadu_pd(r + i)));
+    }
+    circlePerimeterScalar(r + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+void rectPerimeterAVX2(const double *w, const double *h, size_t n, double *out) {
+    const __m256d two = _mm256_set1_pd(2);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i));
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(two, sum));
+    }
+    rectPerimeterScalar(w + i, h + i, n - i, out + i);
+}
+
+// Two accumulators so consecutive adds do not wait on each other
+__attribute__((target("avx2")))
+double circleAreaSumAVX2(const double *r, size_t n) {
+    const __m256d pi = _mm256_set1_pd(PI);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(r + i), x1 = _mm256_loadu_pd(r + i + 4);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_mul_pd(pi, x0), x0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_mul_pd(pi, x1), x1));
+    }
+    return horizontalSum(_mm256_add_pd(acc0, acc1)) + circleAreaSumScalar(r + i, n - i);
+}
+
+__attribute__((target("avx2")))
+double rectAreaSumAVX2(const double *w, const double *h, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(w + i + 4), _mm256_loadu_pd(h + i + 4)));
+    }
+    return horizontalSum(_mm256_add_pd(acc0, acc1)) + rectAreaSumScalar(w + i, h + i, n - i);
+}
+
+// Areas 4 at a time in a register, then one add per lane into that lane's bins
+__attribute__((target("avx2")))
+void circleAreaByColorAVX2(const double *r, const uint32_t *colors, size_t n, double *bins, size_t colorCount) {
+    const __m256d pi = _mm256_set1_pd(PI);
+    alignas(32) double a[4];
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(r + i);
+        _mm256_store_pd(a, _mm256_mul_pd(_mm256_mul_pd(pi, x), x));
+        bins[colors[i]] += a[0];
+        bins[colorCount + colors[i + 1]] += a[1];
+        bins[2 * colorCount + colors[i + 2]] += a[2];
+        bins[3 * colorCount + colors[i + 3]] += a[3];
+    }
+    for (; i < n; i++) bins[(i & 3) * colorCount + colors[i]] += PI * r[i] * r[i];
+}
+
+__attribute__((target("avx2")))
+void rectAreaByColorAVX2(const double *w, const double *h, const uint32_t *colors, size_t n,
+                         double *bins, size_t colorCount) {
+    alignas(32) double a[4];
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_store_pd(a, _mm256_mul_pd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i)));
+        bins[colors[i]] += a[0];
+        bins[colorCount + colors[i + 1]] += a[1];
+        bins[2 * colorCount + colors[i + 2]] += a[2];
+        bins[3 * colorCount + colors[i + 3]] += a[3];
+    }
+    for (; i < n; i++) bins[(i & 3) * colorCount + colors[i]] += w[i] * h[i];
+}
+
+__attribute__((target("avx2")))
+double circleAreaForColorAVX2(const double *r, const uint32_t *colors, size_t n, uint32_t color) {
+    const __m256d pi = _mm256_set1_pd(PI);
+    const __m128i wanted = _mm_set1_epi32(int(color));
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(r + i), x1 = _mm256_loadu_pd(r + i + 4);
+        __m256d a0 = _mm256_mul_pd(_mm256_mul_pd(pi, x0), x0);
+        __m256d a1 = _mm256_mul_pd(_mm256_mul_pd(pi, x1), x1);
+        acc0 = _mm256_add_pd(acc0, _mm256_and_pd(a0, colorMask(colors + i, wanted)));
+        acc1 = _mm256_add_pd(acc1, _mm256_and_pd(a1, colorMask(colors + i + 4, wanted)));
+    }
+    return horizontalSum(_mm256_add_pd(acc0, acc1)) + circleAreaForColorScalar(r + i, colors + i, n - i, color);
+}
+
+__attribute__((target("avx2")))
+double rectAreaForColorAVX2(const double *w, const double *h, const uint32_t *colors, size_t n, uint32_t color) {
+    const __m128i wanted = _mm_set1_epi32(int(color));
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a0 = _mm256_mul_pd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i));
+        __m256d a1 = _mm256_mul_pd(_mm256_loadu_pd(w + i + 4), _mm256_loadu_pd(h + i + 4));
+        acc0 = _mm256_add_pd(acc0, _mm256_and_pd(a0, colorMask(colors + i, wanted)));
+        acc1 = _mm256_add_pd(acc1, _mm256_and_pd(a1, colorMask(colors + i + 4, wanted)));
+    }
+    return horizontalSum(_mm256_add_pd(acc0, acc1)) + rectAreaForColorScalar(w + i, h + i, colors + i, n - i, color);
+}
+
+__attribute__((target("avx2")))
+size_t filterColorAVX2(const uint32_t *colors, size_t n, uint32_t color, uint32_t *out) {
+    const __m256i wanted = _mm256_set1_epi32(int(color));
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i ids = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colors + i));
+        unsigned bits = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(ids, wanted))));
+        while (bits) {
+            out[count++] = uint32_t(i) + uint32_t(__builtin_ctz(bits));
+            bits &= bits - 1;
+        }
+    }
+    for (; i < n; i++) {
+        if (colors[i] == color) out[count++] = uint32_t(i);
+    }
+    return count;
+}
+#endif
+
+// ============= DISPATCH =============
+
+/*
+Same pattern as 13_String_Kernels.cpp: one function table per level,
+the best one picked once at startup; kernelLevels() lists every level
+the CPU supports so the benchmark can compare them.
+*/
+struct ShapeKernels {
+    void (*circleArea)(const double*, size_t, double*);
+    void (*rectArea)(const double*, const double*, size_t, double*);
+    void (*circlePerimeter)(const double*, size_t, double*);
+    void (*rectPerimeter)(const double*, const double*, size_t, double*);
+    double (*circleAreaSum)(const double*, size_t);
+    double (*rectAreaSum)(const double*, const double*, size_t);
+    void (*circleAreaByColor)(const double*, const uint32_t*, size_t, double*, size_t);
+    void (*rectAreaByColor)(const double*, const double*, const uint32_t*, size_t, double*, size_t);
+    double (*circleAreaForColor)(const double*, const uint32_t*, size_t, uint32_t);
+    double (*rectAreaForColor)(const double*, const double*, const uint32_t*, size_t, uint32_t);
+    size_t (*filterColor)(const uint32_t*, size_t, uint32_t, uint32_t*);
+    const char *name;
+};
+
+vector<ShapeKernels> kernelLevels() {
+    vector<ShapeKernels> levels;
+    levels.push_back({circleAreaScalar, rectAreaScalar, circlePerimeterScalar, rectPerimeterScalar,
+                      circleAreaSumScalar, rectAreaSumScalar, circleAreaByColorScalar, rectAreaByColorScalar,
+                      circleAreaForColorScalar, rectAreaForColorScalar, filterColorScalar, "scalar"});
+#ifdef SHAPES_HAVE_X86
+    if (__builtin_cpu_supports("avx2")) {
+        levels.push_back({circleAreaAVX2, rectAreaAVX2, circlePerimeterAVX2, rectPerimeterAVX2,
+                          circleAreaSumAVX2, rectAreaSumAVX2, circleAreaByColorAVX2, rectAreaByColorAVX2,
+                          circleAreaForColorAVX2, rectAreaForColorAVX2, filterColorAVX2, "AVX2"});
+    }
+#endif
+    return levels;
+}
+
+const ShapeKernels& kernels() {
+    static const ShapeKernels best = kernelLevels().back();
+    return best;
+}
+
+// ============= ALIGNED COLUMN =============
+
+/*
+A minimal vector of plain numbers whose block is 64-byte aligned, so
+every column starts on a cache line.
+*/
+template <typename T>
+class AlignedArray {
+    static_assert(is_trivially_copyable_v<T>, "columns hold plain numbers");
+
+    private:
+        static constexpr size_t ALIGNMENT = 64;
+
+        T *data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+
+    public:
+        AlignedArray() = default;
+        AlignedArray(const AlignedArray&) = delete;
+        AlignedArray& operator=(const AlignedArray&) = delete;
+
+        ~AlignedArray() {
+            if (data_) ::operator delete(data_, align_val_t(ALIGNMENT));
+        }
+
+        void reserve(size_t capacity) {
+            if (capacity <= capacity_) return;
+            T *fresh = static_cast<T*>(::operator new(capacity * sizeof(T), align_val_t(ALIGNMENT)));
+            if (size_) memcpy(fresh, data_, size_ * sizeof(T));
+            if (data_) ::operator delete(data_, align_val_t(ALIGNMENT));
+            data_ = fresh;
+            capacity_ = capacity;
+        }
+
+        void push_back(T value) {
+            if (size_ == capacity_) reserve(max<size_t>(16, capacity_ * 2));
+            data_[size_++] = value;
+        }
+
+        T& operator[](size_t i) { return data_[i]; }
+        const T& operator[](size_t i) const { return data_[i]; }
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+        size_t size() const { return size_; }
+};
+
+// ============= SHAPE STORE =============
+
+/*
+Circles and rectangles live in separate column groups, so every kernel
+runs over one kind of shape with no per-shape branch. Colors are
+interned: "Red" is stored once and every shape keeps a 4-byte id
+(22_String_Interning.cpp has the full thread-safe version).
+
+Per-shape outputs (areas, perimeters) are written to caller buffers of
+circleCount() / rectangleCount() elements.
+*/
+class ShapeStore {
+    private:
+        AlignedArray<double> radius;
+        AlignedArray<uint32_t> circleColor;
+        AlignedArray<double> width;
+        AlignedArray<double> height;
+        AlignedArray<uint32_t> rectColor;
+
+        vector<string> colorNames;
+        unordered_map<string, uint32_t> colorIds;
+
+    public:
+        static constexpr uint32_t NO_COLOR = 0xFFFFFFFF;
+
+        uint32_t internColor(string_view name) {
+            auto it = colorIds.find(string(name));
+            if (it != colorIds.end()) return it->second;
+            uint32_t id = uint32_t(colorNames.size());
+            colorNames.emplace_back(name);
+            colorIds.emplace(colorNames.back(), id);
+            return id;
+        }
+
+        // NO_COLOR if no shape ever used this color
+        uint32_t findColor(string_view name) const {
+            auto it = colorIds.find(string(name));
+            return it == colorIds.end() ? NO_COLOR : it->second;
+        }
+
+        const string& colorName(uint32_t id) const { return colorNames.at(id); }
+        size_t colorCount() const { return colorNames.size(); }
+
+        void reserve(size_t circles, size_t rectangles) {
+            radius.reserve(circles);
+            circleColor.reserve(circles);
+            width.reserve(rectangles);
+            height.reserve(rectangles);
+            rectColor.reserve(rectangles);
+        }
+
+        // Returns the new circle's index
+        size_t addCircle(string_view color, double r) {
+            radius.push_back(r);
+            circleColor.push_back(internColor(color));
+            return radius.size() - 1;
+        }
+
+        size_t addRectangle(string_view color, double w, double h) {
+            width.push_back(w);
+            height.push_back(h);
+            rectColor.push_back(internColor(color));
+            return width.size() - 1;
+        }
+
+        size_t circleCount() const { return radius.size(); }
+        size_t rectangleCount() const { return width.size(); }
+
+        // ===== BATCH KERNELS =====
+
+        void circleAreas(double *out, const ShapeKernels &k = kernels()) const {
+            k.circleArea(radius.data(), radius.size(), out);
+        }
+
+        void rectangleAreas(double *out, const ShapeKernels &k = kernels()) const {
+            k.rectArea(width.data(), height.data(), width.size(), out);
+        }
+
+        void circlePerimeters(double *out, const ShapeKernels &k = kernels()) const {
+            k.circlePerimeter(radius.data(), radius.size(), out);
+        }
+
+        void rectanglePerimeters(double *out, const ShapeKernels &k = kernels()) const {
+            k.rectPerimeter(width.data(), height.data(), width.size(), out);
+        }
+
+        double totalArea(const ShapeKernels &k = kernels()) const {
+            return k.circleAreaSum(radius.data(), radius.size()) +
+                   k.rectAreaSum(width.data(), height.data(), width.size());
+        }
+
+        // Total area of the shapes of one color (masked sum, no branch per shape)
+        double areaForColor(uint32_t color, const ShapeKernels &k = kernels()) const {
+            return k.circleAreaForColor(radius.data(), circleColor.data(), radius.size(), color) +
+                   k.rectAreaForColor(width.data(), height.data(), rectColor.data(), width.size(), color);
+        }
+
+        // result[id] = total area of all shapes with color id, in one pass
+        vector<double> sumAreaByColor(const ShapeKernels &k = kernels()) const {
+            size_t colors = colorNames.size();
+            vector<double> bins(4 * colors), sums(colors);
+            k.circleAreaByColor(radius.data(), circleColor.data(), radius.size(), bins.data(), colors);
+            k.rectAreaByColor(width.data(), height.data(), rectColor.data(), width.size(), bins.data(), colors);
+            for (size_t id = 0; id < colors; id++) {
+                sums[id] = (bins[id] + bins[colors + id]) + (bins[2 * colors + id] + bins[3 * colors + id]);
+            }
+            return sums;
+        }
+
+        // Indices of the circles / rectangles with the given color
+        vector<uint32_t> circlesWithColor(uint32_t color, const ShapeKernels &k = kernels()) const {
+            vector<uint32_t> out(radius.size());
+            out.resize(k.filterColor(circleColor.data(), circleColor.size(), color, out.data()));
+            return out;
+        }
+
+        vector<uint32_t> rectanglesWithColor(uint32_t color, const ShapeKernels &k = kernels()) const {
+            vector<uint32_t> out(width.size());
+            out.resize(k.filterColor(rectColor.data(), rectColor.size(), color, out.data()));
+            return out;
+        }
+};
+
+// ============= VALIDATION =============
+
+bool closeEnough(double a, double b) {
+    return fabs(a - b) <= 1e-9 * max(fabs(a), fabs(b));
+}
+
+// Every kernel level against the per-object methods
+bool validate(const ShapeStore &store, const vector<Circle> &circles, const vector<Rectangle> &rects) {
+    bool ok = true;
+    vector<double> c(store.circleCount()), r(store.rectangleCount());
+    for (const ShapeKernels &k : kernelLevels()) {
+        store.circleAreas(c.data(), k);
+        store.rectangleAreas(r.data(), k);
+        for (size_t i = 0; i < circles.size(); i++) ok &= c[i] == circles[i].getArea();
+        for (size_t i = 0; i < rects.size(); i++) ok &= r[i] == rects[i].getArea();
+
+        store.circlePerimeters(c.data(), k);
+        store.rectanglePerimeters(r.data(), k);
+        for (size_t i = 0; i < circles.size(); i++) ok &= c[i] == circles[i].getPerimeter();
+        for (size_t i = 0; i < rects.size(); i++) ok &= r[i] == rects[i].getPerimeter();
+
+        double total = 0;
+        for (const Circle &s : circles) total += s.getArea();
+        for (const Rectangle &s : rects) total += s.getArea();
+        ok &= closeEnough(store.totalArea(k), total);
+
+        vector<double> byColor = store.sumAreaByColor(k);
+        for (uint32_t id = 0; id < store.colorCount(); id++) {
+            const string &name = store.colorName(id);
+            double expected = 0;
+            for (const Circle &s : circles) if (s.getColor() == name) expected += s.getArea();
+            for (const Rectangle &s : rects) if (s.getColor() == name) expected += s.getArea();
+            ok &= closeEnough(byColor[id], expected) && closeEnough(store.areaForColor(id, k), expected);
+
+            vector<uint32_t> picked = store.circlesWithColor(id, k);
+            size_t j = 0;
+            for (size_t i = 0; i < circles.size(); i++) {
+                if (circles[i].getColor() == name) ok &= j < picked.size() && picked[j++] == i;
+            }
+            ok &= j == picked.size();
+
+            picked = store.rectanglesWithColor(id, k);
+            j = 0;
+            for (size_t i = 0; i < rects.size(); i++) {
+                if (rects[i].getColor() == name) ok &= j < picked.size() && picked[j++] == i;
+            }
+            ok &= j == picked.size();
+        }
+        if (!ok) {
+            cout << "  " << k.name << " kernels disagree with the per-object methods!\n";
+            return false;
+        }
+    }
+    return ok;
+}
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+const char *COLORS[] = {"Red", "Blue", "Green", "Black", "Purple", "White", "Midnight Purple Metallic"};
+constexpr size_t COLOR_COUNT = sizeof(COLORS) / sizeof(COLORS[0]);
+
+double sink = 0;  // printed at the end so results are not optimized away
+
+void benchmark(size_t n, int reps) {
+    cout << "\n--- BENCHMARK: " << n << " shapes (half circles), " << COLOR_COUNT << " colors ---\n";
+
+    mt19937_64 rng(11);
+    uniform_real_distribution<double> size(0.5, 20);
+    vector<Circle> circles;
+    vector<Rectangle> rects;
+    circles.reserve(n / 2);
+    rects.reserve(n - n / 2);
+    ShapeStore store;
+    store.reserve(n / 2, n - n / 2);
+    for (size_t i = 0; i < n / 2; i++) {
+        const char *color = COLORS[rng() % COLOR_COUNT];
+        double r = size(rng);
+        circles.emplace_back(color, r);
+        store.addCircle(color, r);
+    }
+    for (size_t i = n / 2; i < n; i++) {
+        const char *color = COLORS[rng() % COLOR_COUNT];
+        double w = size(rng), h = size(rng);
+        rects.emplace_back(color, w, h);
+        store.addRectangle(color, w, h);
+    }
+
+    cout << "  bytes per shape: Circle object " << sizeof(Circle) << ", store "
+         << sizeof(double) + sizeof(uint32_t) << " (circle) / " << 2 * sizeof(double) + sizeof(uint32_t)
+         << " (rectangle)\n";
+
+    // Per-object versions of the three queries
+    double totalMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            double sum = 0;
+            for (const Circle &s : circles) sum += s.getArea();
+            for (const Rectangle &s : rects) sum += s.getArea();
+            sink += sum;
+        }
+    });
+    double byColorMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            map<string, double> sums;
+            for (const Circle &s : circles) sums[s.getColor()] += s.getArea();
+            for (const Rectangle &s : rects) sums[s.getColor()] += s.getArea();
+            sink += sums["Purple"];
+        }
+    });
+    string wanted = "Purple";
+    double filterMs = timeMs([&] {
+        for (int r = 0; r < reps; r++) {
+            vector<uint32_t> picked;
+            for (size_t i = 0; i < circles.size(); i++) {
+                if (circles[i].getColor() == wanted) picked.push_back(uint32_t(i));
+            }
+            sink += double(picked.size());
+        }
+    });
+    cout << "  per-object methods:\n"
+         << "      total area " << totalMs / reps << " ms, area by color " << byColorMs / reps
+         << " ms, filter circles " << filterMs / reps << " ms\n";
+
+    uint32_t purple = store.findColor("Purple");
+    vector<double> areas(store.circleCount());
+    if (purple == ShapeStore::NO_COLOR || areas.empty()) {
+        cout << "  (too few shapes for the ShapeStore timings)\n";
+        return;
+    }
+    for (const ShapeKernels &k : kernelLevels()) {
+        double storeTotalMs = timeMs([&] {
+            for (int r = 0; r < reps; r++) sink += store.totalArea(k);
+        });
+        double storeByColorMs = timeMs([&] {
+            for (int r = 0; r < reps; r++) sink += store.sumAreaByColor(k)[purple];
+        });
+        double storeOneColorMs = timeMs([&] {
+            for (int r = 0; r < reps; r++) sink += store.areaForColor(purple, k);
+        });
+        double storeFilterMs = timeMs([&] {
+            for (int r = 0; r < reps; r++) sink += double(store.circlesWithColor(purple, k).size());
+        });
+        double storeAreasMs = timeMs([&] {
+            for (int r = 0; r < reps; r++) {
+                store.circleAreas(areas.data(), k);
+                sink += areas[r % areas.size()];
+            }
+        });
+        cout << "  ShapeStore, " << k.name << ":\n"
+             << "      total area " << storeTotalMs / reps << " ms, area by color " << storeByColorMs / reps
+             << " ms, area of Purple " << storeOneColorMs / reps << " ms,\n"
+             << "      filter circles " << storeFilterMs / reps << " ms, all circle areas "
+             << storeAreasMs / reps << " ms\n";
+    }
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  STRUCTURE-OF-ARRAYS SHAPE STORE\n";
+    cout << "========================================\n";
+
+    cout << "\nKernel levels on this CPU:";
+    for (const ShapeKernels &k : kernelLevels()) cout << " " << k.name;
+    cout << "\n";
+
+    // ===== THE STORE =====
+    cout << "\n--- ShapeStore ---\n";
+    ShapeStore store;
+    store.addCircle("Red", 5);             // 04: Circle("Red", 5)
+    store.addRectangle("Blue", 4, 6);      // 04: Rectangle("Blue", 4, 6)
+    store.addCircle("Blue", 2);
+    store.addRectangle("Red", 3, 3);
+
+    vector<double> circleAreas(store.circleCount()), rectAreas(store.rectangleCount());
+    store.circleAreas(circleAreas.data());
+    store.rectangleAreas(rectAreas.data());
+    cout << "circle areas:";
+    for (double a : circleAreas) cout << " " << a;
+    cout << "\nrectangle areas:";
+    for (double a : rectAreas) cout << " " << a;
+    cout << "\n";
+    vector<double> byColor = store.sumAreaByColor();
+    for (uint32_t id = 0; id < store.colorCount(); id++) {
+        cout << store.colorName(id) << " area: " << byColor[id] << "\n";
+    }
+
+    // ===== VALIDATION =====
+    cout << "\n--- Validation against Circle::getArea() / Rectangle::getArea() ---\n";
+    {
+        mt19937_64 rng(3);
+        uniform_real_distribution<double> size(0.1, 50);
+        vector<Circle> circles;
+        vector<Rectangle> rects;
+        ShapeStore check;
+        for (int i = 0; i < 10007; i++) {  // odd count: exercises the scalar tails
+            const char *color = COLORS[rng() % COLOR_COUNT];
+            double r = size(rng);
+            circles.emplace_back(color, r);
+            check.addCircle(color, r);
+            color = COLORS[rng() % COLOR_COUNT];
+            double w = size(rng), h = size(rng);
+            rects.emplace_back(color, w, h);
+            check.addRectangle(color, w, h);
+        }
+        cout << "all kernel levels match: " << boolalpha << validate(check, circles, rects) << "\n";
+    }
+
+    // ===== BENCHMARK =====
+    // ./soa 10000000 10
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    int reps = argc > 2 ? atoi(argv[2]) : 10;
+    benchmark(n, reps);
+    cout << "(checksum " << sink << ")\n";
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ARRAY OF STRUCTS vs STRUCT OF ARRAYS:
+   - AoS: each object carries every field; a loop over one field
+     loads all of them
+   - SoA: one array per field; a loop loads only what it uses
+
+2. SEPARATE COLUMN GROUPS PER KIND:
+   - Circles and rectangles in their own arrays: no branch per shape
+   - Colors interned to 4-byte ids: compare ids, not strings
+
+3. AVX2 KERNELS:
+   - 4 doubles per instruction for area and perimeter
+   - Masked sums: compare ids, widen the mask, AND, add
+   - Group sums: one pass, 4 copies of the bins so lanes never collide
+   - Filters: compare 8 ids, movemask, turn set bits into indices
+
+4. VALIDATE:
+   - Same operation order (no FMA) = bit-identical per-shape results
+   - Sums in a different order: compare with a relative tolerance
+
+COMPILATION:
+    g++ -std=c++17 -O2 25_SoA_Shape_Store.cpp -o soa && ./soa
+    ./soa 10000000 10   (shapes, repetitions)
+
+NEXT STEP: Store vehicles as components (ECS)!
+*/
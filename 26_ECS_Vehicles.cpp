@@ -0,0 +1,594 @@
+/*
+=============================================================
+     ENTITY-COMPONENT VEHICLE WORLD - PERFORMANCE TUTORIAL
+     File: 26_ECS_Vehicles.cpp
+=============================================================
+Learn: entities as ids, dense component arrays, sparse-set pools for
+       optional components, systems as tight loops, blocking and
+       splitting systems across threads
+
+03_OOP_Classes.cpp and 04_Inheritance_Polymorphism.cpp model every
+vehicle as its own object and drive it through methods:
+
+    class Car : public Vehicle {       // Vehicle: brand, color, year
+        int doors;
+    };
+    void accelerate(double amount) {
+        speed += amount;
+        cout << brand << " " << model << " is accelerating..." << endl;
+    }
+
+Stepping a fleet of millions this way means one heap object per vehicle,
+one virtual call per vehicle per step, and the CPU loading two strings
+and a vptr to change one double.
+
+The World below keeps the same data as components:
+
+    entity:    0      1      2      3    ...     (just an index)
+    brand[]    Toyota Yamaha Honda  BMW
+    color[]    Red    Blue   Black  White        (interned ids)
+    year[]     2020   2021   2019   2022
+    speed[]    ...                               (every vehicle)
+    doors      {0: 4, 2: 2}                      (cars only)
+    storage    {1: true, 3: false}               (bikes only)
+
+A system is a function over the arrays it needs. Acceleration touches
+speed/throttle/maxSpeed and nothing else, in a loop the compiler turns
+into SIMD code, and the entity range splits cleanly across threads.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// ============= OBJECT-PER-VEHICLE DESIGN =============
+
+/*
+The 04 hierarchy with 03's speed and accelerate/brake, minus the
+printing (17_Fast_Output.cpp covers that cost). Each type has its own
+top speed through a virtual call. The driver's inputs (throttle, brake)
+live on the object too, as they would in a simulation.
+*/
+class Vehicle {
+    protected:
+        string brand;
+        string color;
+        int year;
+        double speed = 0;
+        double odometer = 0;
+        double throttle, brakeForce;
+
+    public:
+        Vehicle(string b, string c, int y, double throttle, double brakeForce)
+            : brand(move(b)), color(move(c)), year(y), throttle(throttle), brakeForce(brakeForce) {}
+
+        virtual double maxSpeed() const = 0;
+
+        void accelerate(double amount) {
+            speed += amount;
+            if (speed > maxSpeed()) speed = maxSpeed();
+        }
+
+        void brake(double amount) {
+            speed -= amount;
+            if (speed < 0) speed = 0;
+        }
+
+        // One simulation step of `hours`
+        void step(double hours) {
+            accelerate(throttle);
+            brake(brakeForce);
+            odometer += speed * hours;
+        }
+
+        double getSpeed() const { return speed; }
+        double getOdometer() const { return odometer; }
+        virtual ~Vehicle() {}
+};
+
+class Car : public Vehicle {
+    private:
+        int doors;
+
+    public:
+        Car(string b, string c, int y, int d, double throttle, double brakeForce)
+            : Vehicle(move(b), move(c), y, throttle, brakeForce), doors(d) {}
+
+        double maxSpeed() const override { return 200; }
+};
+
+class Bike : public Vehicle {
+    private:
+        bool hasStorage;
+
+    public:
+        Bike(string b, string c, int y, bool storage, double throttle, double brakeForce)
+            : Vehicle(move(b), move(c), y, throttle, brakeForce), hasStorage(storage) {}
+
+        double maxSpeed() const override { return 150; }
+};
+
+// ============= THREAD POOL =============
+
+/*
+The pool from 12_Parallel_Sort.cpp. The calling thread works too, so a
+pool with k workers runs a system on k + 1 threads.
+*/
+class ThreadPool {
+    private:
+        vector<thread> workers;
+        queue<function<void()>> tasks;
+        mutex mtx;
+        condition_variable cv;
+        bool stopping = false;
+
+    public:
+        explicit ThreadPool(size_t threads) {
+            for (size_t i = 0; i < threads; i++) {
+                workers.emplace_back([this] {
+                    while (true) {
+                        function<void()> task;
+                        {
+                            unique_lock<mutex> lock(mtx);
+                            cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                            if (stopping && tasks.empty()) return;
+                            task = move(tasks.front());
+                            tasks.pop();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                lock_guard<mutex> lock(mtx);
+                stopping = true;
+            }
+            cv.notify_all();
+            for (thread &t : workers) t.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t size() const {
+            return workers.size();
+        }
+
+        // Runs body(begin, end) over [0, n) split into chunks of at least
+        // minChunk elements and waits until every chunk is finished.
+        template <typename Body>
+        void parallelFor(size_t n, size_t minChunk, Body body) {
+            minChunk = max<size_t>(minChunk, 1);
+            size_t chunks = min(workers.size() + 1, (n + minChunk - 1) / minChunk);
+            if (chunks <= 1) {
+                body(size_t(0), n);
+                return;
+            }
+            // Chunk c is [c * n / chunks, (c + 1) * n / chunks): sizes differ
+            // by at most 1 and, since chunks <= n, none is empty
+            size_t pending = chunks - 1;
+            mutex doneMtx;
+            condition_variable doneCv;
+            {
+                lock_guard<mutex> lock(mtx);
+                for (size_t c = 1; c < chunks; c++) {
+                    size_t b = c * n / chunks, e = (c + 1) * n / chunks;
+                    tasks.push([&, b, e] {
+                        body(b, e);
+                        lock_guard<mutex> done(doneMtx);
+                        if (--pending == 0) doneCv.notify_one();
+                    });
+                }
+            }
+            cv.notify_all();
+            body(size_t(0), n / chunks);
+            unique_lock<mutex> lock(doneMtx);
+            doneCv.wait(lock, [&] { return pending == 0; });
+        }
+};
+
+// ============= COMPONENT STORAGE =============
+
+using Entity = uint32_t;
+
+// Strings that repeat across millions of entities (brands, colors) are
+// stored once; components hold the 4-byte id
+class NameTable {
+    private:
+        vector<string> names;
+        unordered_map<string, uint32_t> ids;
+
+    public:
+        uint32_t intern(const string &name) {
+            auto it = ids.find(name);
+            if (it != ids.end()) return it->second;
+            uint32_t id = uint32_t(names.size());
+            names.push_back(name);
+            ids.emplace(name, id);
+            return id;
+        }
+
+        const string& name(uint32_t id) const { return names[id]; }
+        size_t size() const { return names.size(); }
+};
+
+/*
+Storage for a component only SOME entities have (doors: cars only).
+A sparse set:
+
+    values[]    packed, no holes: loops over it are as fast as a vector
+    owners[]    owners[k] = the entity values[k] belongs to
+    slot[]      slot[e] = k, or NONE if e has no component
+
+has/get are one array lookup, add appends, forEach walks the packed
+array. Doors and storage flags never leave the entity in this demo, so
+there is no remove.
+*/
+template <typename T>
+class ComponentPool {
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+        vector<T> values;
+        vector<Entity> owners;
+        vector<uint32_t> slot;
+
+    public:
+        void add(Entity e, T value) {
+            if (e >= slot.size()) slot.resize(size_t(e) + 1, NONE);
+            if (slot[e] != NONE) {
+                values[slot[e]] = value;
+                return;
+            }
+            slot[e] = uint32_t(values.size());
+            values.push_back(value);
+            owners.push_back(e);
+        }
+
+        bool has(Entity e) const { return e < slot.size() && slot[e] != NONE; }
+        const T& get(Entity e) const { return values[slot[e]]; }
+        size_t size() const { return values.size(); }
+
+        void reserve(size_t entities, size_t components) {
+            slot.reserve(entities);
+            values.reserve(components);
+            owners.reserve(components);
+        }
+
+        // f(entity, value) for every entity that has the component
+        template <typename Func>
+        void forEach(Func f) const {
+            for (size_t k = 0; k < values.size(); k++) f(owners[k], values[k]);
+        }
+
+        size_t bytes() const {
+            return values.size() * sizeof(T) + owners.size() * sizeof(Entity) + slot.size() * sizeof(uint32_t);
+        }
+};
+
+// ============= SYSTEMS =============
+
+/*
+Each system is a plain loop over raw column pointers for [0, n). No
+branches the compiler cannot turn into min/max, __restrict so it knows
+the columns do not overlap: with -O3 (or -O2 on newer compilers) these
+become packed SIMD instructions.
+
+The steps match Vehicle::accelerate / brake / step exactly, so both
+designs produce the same speeds.
+*/
+void accelerationSystem(double *__restrict speed, const double *__restrict throttle,
+                        const double *__restrict maxSpeed, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s = speed[i] + throttle[i];
+        speed[i] = s > maxSpeed[i] ? maxSpeed[i] : s;
+    }
+}
+
+void brakingSystem(double *__restrict speed, const double *__restrict brakeForce, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s = speed[i] - brakeForce[i];
+        speed[i] = s < 0 ? 0 : s;
+    }
+}
+
+void movementSystem(double *__restrict odometer, const double *__restrict speed, double hours, size_t n) {
+    for (size_t i = 0; i < n; i++) odometer[i] += speed[i] * hours;
+}
+
+// ============= THE WORLD =============
+
+/*
+Components every vehicle has are dense columns indexed by entity id.
+Optional ones (doors, storage) are sparse sets.
+
+step() runs the three systems in blocks of BLOCK entities: acceleration,
+braking and movement on entities 0..2047, then on 2048..4095, and so on.
+A block's columns (~80 KB) are still in cache for the second and third
+system, instead of streaming every column from memory three times.
+With a pool, each thread takes its own range of blocks; no two threads
+write the same entity, so no locks are needed.
+*/
+class World {
+    private:
+        static constexpr size_t BLOCK = 2048;
+
+        // Dense components (index = entity)
+        vector<uint32_t> brand, color;
+        vector<uint16_t> year;
+        vector<double> speed, maxSpeed, throttle, brakeForce, odometer;
+
+        // Optional components
+        ComponentPool<uint8_t> doors;     // cars
+        ComponentPool<uint8_t> storage;   // bikes (not bool: vector<bool> packs bits)
+
+        NameTable brands, colors;
+
+        Entity create(const string &b, const string &c, int y, double top, double thr, double brk) {
+            Entity e = Entity(speed.size());
+            brand.push_back(brands.intern(b));
+            color.push_back(colors.intern(c));
+            year.push_back(uint16_t(y));
+            speed.push_back(0);
+            maxSpeed.push_back(top);
+            throttle.push_back(thr);
+            brakeForce.push_back(brk);
+            odometer.push_back(0);
+            return e;
+        }
+
+        void stepRange(size_t begin, size_t end, double hours) {
+            for (size_t b = begin; b < end; b += BLOCK) {
+                size_t n = min(BLOCK, end - b);
+                accelerationSystem(&speed[b], &throttle[b], &maxSpeed[b], n);
+                brakingSystem(&speed[b], &brakeForce[b], n);
+                movementSystem(&odometer[b], &speed[b], hours, n);
+            }
+        }
+
+    public:
+        void reserve(size_t n) {
+            for (auto *column : {&brand, &color}) column->reserve(n);
+            year.reserve(n);
+            for (auto *column : {&speed, &maxSpeed, &throttle, &brakeForce, &odometer}) column->reserve(n);
+        }
+
+        // Top speeds match Car::maxSpeed() / Bike::maxSpeed()
+        Entity createCar(const string &b, const string &c, int y, int d, double thr, double brk) {
+            Entity e = create(b, c, y, 200, thr, brk);
+            doors.add(e, uint8_t(d));
+            return e;
+        }
+
+        Entity createBike(const string &b, const string &c, int y, bool hasStorage, double thr, double brk) {
+            Entity e = create(b, c, y, 150, thr, brk);
+            storage.add(e, uint8_t(hasStorage));
+            return e;
+        }
+
+        // One simulation tick for every entity
+        void step(double hours) {
+            stepRange(0, speed.size(), hours);
+        }
+
+        void step(double hours, ThreadPool &pool) {
+            size_t n = speed.size();
+            // Chunks are whole blocks, so each thread's blocks stay aligned
+            pool.parallelFor((n + BLOCK - 1) / BLOCK, 16, [&](size_t b, size_t e) {
+                stepRange(b * BLOCK, min(n, e * BLOCK), hours);
+            });
+        }
+
+        size_t size() const { return speed.size(); }
+        size_t cars() const { return doors.size(); }
+        size_t bikes() const { return storage.size(); }
+        bool isCar(Entity e) const { return doors.has(e); }
+        int doorCount(Entity e) const { return doors.get(e); }
+        bool hasStorage(Entity e) const { return storage.get(e) != 0; }
+
+        const string& brandName(Entity e) const { return brands.name(brand[e]); }
+        const string& colorName(Entity e) const { return colors.name(color[e]); }
+        int yearOf(Entity e) const { return year[e]; }
+        double speedOf(Entity e) const { return speed[e]; }
+        double odometerOf(Entity e) const { return odometer[e]; }
+
+        // Example of a query over one optional component: no scan of bikes
+        size_t carsWithDoors(int d) const {
+            size_t count = 0;
+            doors.forEach([&](Entity, uint8_t value) { count += value == d; });
+            return count;
+        }
+
+        size_t bytes() const {
+            return size() * (2 * sizeof(uint32_t) + sizeof(uint16_t) + 5 * sizeof(double)) +
+                   doors.bytes() + storage.bytes();
+        }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+struct VehicleSpec {
+    bool car;
+    int brand, color, year, doors;
+    bool storage;
+    double throttle, brakeForce;
+};
+
+const char *BRANDS[] = {"Toyota", "Honda", "BMW", "Yamaha", "Ford", "Ducati", "Tesla", "Suzuki"};
+const char *COLORS[] = {"Red", "Blue", "Black", "White", "Silver", "Purple"};
+
+void benchmark(size_t n, int ticks) {
+    cout << "\n--- BENCHMARK: " << n << " vehicles, " << ticks << " ticks ---\n";
+    const double hours = 1.0 / 3600;  // one tick = one second
+
+    mt19937 rng(42);
+    uniform_real_distribution<double> input(0, 10);
+    vector<VehicleSpec> specs(n);
+    for (VehicleSpec &s : specs) {
+        s.car = rng() % 2 == 0;
+        s.brand = int(rng() % 8);
+        s.color = int(rng() % 6);
+        s.year = 2000 + int(rng() % 25);
+        s.doors = rng() % 2 ? 4 : 2;
+        s.storage = rng() % 2;
+        s.throttle = input(rng);
+        s.brakeForce = input(rng);
+    }
+
+    // 1. Object per vehicle, stepped through Vehicle*
+    vector<unique_ptr<Vehicle>> fleet;
+    fleet.reserve(n);
+    for (const VehicleSpec &s : specs) {
+        if (s.car) {
+            fleet.push_back(make_unique<Car>(BRANDS[s.brand], COLORS[s.color], s.year, s.doors,
+                                             s.throttle, s.brakeForce));
+        } else {
+            fleet.push_back(make_unique<Bike>(BRANDS[s.brand], COLORS[s.color], s.year, s.storage,
+                                              s.throttle, s.brakeForce));
+        }
+    }
+    double objectMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++)
+            for (auto &v : fleet) v->step(hours);
+    });
+
+    // 2. ECS world, one thread, then every thread
+    World world, parallelWorld;
+    world.reserve(n);
+    parallelWorld.reserve(n);
+    for (const VehicleSpec &s : specs) {
+        for (World *w : {&world, &parallelWorld}) {
+            if (s.car) w->createCar(BRANDS[s.brand], COLORS[s.color], s.year, s.doors, s.throttle, s.brakeForce);
+            else w->createBike(BRANDS[s.brand], COLORS[s.color], s.year, s.storage, s.throttle, s.brakeForce);
+        }
+    }
+    double ecsMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++) world.step(hours);
+    });
+
+    ThreadPool pool(max(1u, thread::hardware_concurrency()) - 1);
+    double parallelMs = timeMs([&] {
+        for (int t = 0; t < ticks; t++) parallelWorld.step(hours, pool);
+    });
+
+    // Speeds must be identical; odometers may differ in the last bit if
+    // the compiler fuses speed * hours + odometer into an FMA in one loop
+    bool same = true;
+    for (size_t i = 0; i < n; i++) {
+        double odo = fleet[i]->getOdometer();
+        same &= fleet[i]->getSpeed() == world.speedOf(Entity(i)) &&
+                world.speedOf(Entity(i)) == parallelWorld.speedOf(Entity(i)) &&
+                abs(odo - world.odometerOf(Entity(i))) <= 1e-12 * (1 + odo) &&
+                world.odometerOf(Entity(i)) == parallelWorld.odometerOf(Entity(i));
+    }
+
+    size_t objectBytes = n * sizeof(unique_ptr<Vehicle>) + n * max(sizeof(Car), sizeof(Bike));
+    auto report = [&](string label, double ms) {
+        label.resize(26, ' ');
+        cout << "  " << label << ": " << ms / ticks << " ms/tick, " << ticks * 1000.0 / ms << " ticks/s, "
+             << double(n) * ticks / ms / 1000 << " M vehicle-steps/s\n";
+    };
+    report("objects, Vehicle* loop", objectMs);
+    report("World, 1 thread", ecsMs);
+    report("World, " + to_string(pool.size() + 1) + (pool.size() ? " threads" : " thread (pool)"), parallelMs);
+    cout << "  memory: objects ~" << objectBytes / (1 << 20) << " MB, World "
+         << world.bytes() / (1 << 20) << " MB\n";
+    cout << "  results match: " << boolalpha << same << "\n";
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  ENTITY-COMPONENT VEHICLE WORLD\n";
+    cout << "========================================\n";
+
+    // ===== A SMALL WORLD =====
+    cout << "\n--- World with 04's vehicles ---\n";
+    World world;
+    Entity myCar = world.createCar("Toyota", "Red", 2020, 4, 20, 5);
+    Entity myBike = world.createBike("Yamaha", "Blue", 2021, true, 15, 5);
+    world.createCar("Honda", "Black", 2019, 2, 8, 10);
+
+    for (int t = 1; t <= 3; t++) {
+        world.step(1.0 / 3600);
+        cout << "tick " << t << ":";
+        for (Entity e = 0; e < world.size(); e++) {
+            cout << "  " << world.brandName(e) << " " << world.speedOf(e) << " km/h";
+        }
+        cout << "\n";
+    }
+    cout << world.brandName(myCar) << " (" << world.colorName(myCar) << ", " << world.yearOf(myCar)
+         << ") has " << world.doorCount(myCar) << " doors\n";
+    cout << world.brandName(myBike) << " has storage: " << boolalpha << world.hasStorage(myBike) << "\n";
+    cout << world.cars() << " cars, " << world.bikes() << " bikes, "
+         << world.carsWithDoors(4) << " car(s) with 4 doors\n";
+
+    // ===== BENCHMARK =====
+    // ./ecs 2000000 100
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 100;
+    benchmark(n, ticks);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ENTITIES AND COMPONENTS:
+   - An entity is just an id (an index)
+   - Components every entity has: one dense array each
+   - Optional components: sparse set (packed values + entity -> slot)
+
+2. SYSTEMS:
+   - A function over only the columns it needs
+   - Branch-free loops over raw pointers with __restrict vectorize
+   - No virtual call, no strings touched in the hot loop
+
+3. BLOCKING:
+   - Run all systems on one cache-sized block before moving on
+   - Each column is read from memory once per tick, not once per system
+
+4. THREADS:
+   - Entities are independent, so split the range: no locks
+   - Hand out whole blocks so threads never share a block
+
+5. TRADE-OFFS:
+   - Reading one whole vehicle touches many arrays
+   - Destroying entities needs swap-remove and id remapping (not shown)
+
+COMPILATION:
+    g++ -std=c++17 -O3 -march=native -pthread 26_ECS_Vehicles.cpp -o ecs && ./ecs
+    ./ecs 2000000 100   (vehicles, ticks)
+
+NEXT STEP: Balance uneven work with work stealing!
+*/
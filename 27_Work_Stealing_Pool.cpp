@@ -0,0 +1,640 @@
+/*
+=============================================================
+     WORK-STEALING THREAD POOL - PERFORMANCE TUTORIAL
+     File: 27_Work_Stealing_Pool.cpp
+=============================================================
+Learn: per-worker deques (Chase-Lev), stealing from the top, parking
+       idle workers, recursive range splitting, deterministic chunks
+       and reductions, scaling from 1 to all cores
+
+03_OOP_Classes.cpp and 04_Inheritance_Polymorphism.cpp drive one
+vehicle at a time:
+
+    myCar.accelerate(50);
+    myCar.brake(20);
+    driveVehicle(&myCar);
+
+Stepping a fleet of millions on one core leaves the rest idle. The pool
+in 12_Parallel_Sort.cpp splits a range into one chunk per thread and
+hands the chunks out through one shared, locked queue. That works when
+every chunk costs the same. When some vehicles are much more expensive
+(city traffic with many physics sub-steps), the thread that got the
+expensive chunk finishes last while the others wait.
+
+WorkStealingPool gives every thread its own deque:
+  - the owner pushes and pops at the BOTTOM (newest first, cache-warm)
+  - idle threads STEAL from the TOP (the oldest, biggest pieces of work)
+  - a thread with nothing to do spins briefly, then parks (sleeps)
+parallel_for(n, grain, body) starts one task covering all chunks; the
+thread running it keeps splitting it in half, pushing the right half
+for others to steal. Chunk boundaries depend only on n and grain, never
+on the thread count, so parallel_reduce gives bit-identical results on
+1 thread or 64.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// ============= HELPERS =============
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    this_thread::yield();
+#endif
+}
+
+// ============= WORK-STEALING DEQUE =============
+
+/*
+The Chase-Lev deque (with the memory orders from Le et al., "Correct and
+Efficient Work-Stealing for Weak Memory Models", 2013).
+
+    top                      bottom
+     v                         v
+    [ t0 ][ t1 ][ t2 ][ t3 ][    ]...      circular buffer
+     ^ thieves CAS top        ^ only the owner moves bottom
+
+push/pop are called only by the owner and cost no atomic RMW, except
+when one item is left and the owner races a thief for it. steal() is
+one CAS on top. When the buffer is full the owner copies it into one
+twice as big; old buffers are kept until the deque dies, because a
+thief may still be reading one.
+
+Items are pointers; nullptr means "empty, or lost a race".
+*/
+template <typename T>
+class WorkStealingDeque {
+    private:
+        struct Buffer {
+            int64_t capacity;
+            unique_ptr<atomic<T*>[]> items;
+
+            explicit Buffer(int64_t cap) : capacity(cap), items(new atomic<T*>[size_t(cap)]) {}
+            T* get(int64_t i) const { return items[size_t(i & (capacity - 1))].load(memory_order_relaxed); }
+            void put(int64_t i, T *x) { items[size_t(i & (capacity - 1))].store(x, memory_order_relaxed); }
+        };
+
+        alignas(64) atomic<int64_t> top{0};
+        alignas(64) atomic<int64_t> bottom{0};
+        atomic<Buffer*> buffer;
+        vector<unique_ptr<Buffer>> buffers;  // current + retired, owner only
+
+    public:
+        explicit WorkStealingDeque(int64_t capacity = 256) {
+            buffers.push_back(make_unique<Buffer>(capacity));
+            buffer.store(buffers.back().get(), memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // Owner only
+        void push(T *x) {
+            int64_t b = bottom.load(memory_order_relaxed);
+            int64_t t = top.load(memory_order_acquire);
+            Buffer *buf = buffer.load(memory_order_relaxed);
+            if (b - t > buf->capacity - 1) {
+                auto bigger = make_unique<Buffer>(buf->capacity * 2);
+                for (int64_t i = t; i < b; i++) bigger->put(i, buf->get(i));
+                buf = bigger.get();
+                buffers.push_back(move(bigger));
+                buffer.store(buf, memory_order_release);
+            }
+            buf->put(b, x);
+            // release: a thief that sees the new bottom also sees the item
+            // (and everything the owner wrote before pushing it)
+            bottom.store(b + 1, memory_order_release);
+        }
+
+        // Owner only: newest item
+        T* pop() {
+            int64_t b = bottom.load(memory_order_relaxed) - 1;
+            Buffer *buf = buffer.load(memory_order_relaxed);
+            bottom.store(b, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            int64_t t = top.load(memory_order_relaxed);
+            if (t > b) {  // empty
+                bottom.store(b + 1, memory_order_relaxed);
+                return nullptr;
+            }
+            T *x = buf->get(b);
+            if (t == b) {  // last item: race the thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                    x = nullptr;
+                }
+                bottom.store(b + 1, memory_order_relaxed);
+            }
+            return x;
+        }
+
+        // Any thread: oldest item
+        T* steal() {
+            int64_t t = top.load(memory_order_acquire);
+            atomic_thread_fence(memory_order_seq_cst);
+            int64_t b = bottom.load(memory_order_acquire);
+            if (t >= b) return nullptr;
+            T *x = buffer.load(memory_order_acquire)->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                return nullptr;
+            }
+            return x;
+        }
+
+        bool empty() const {
+            return top.load(memory_order_acquire) >= bottom.load(memory_order_acquire);
+        }
+};
+
+// ============= WORK-STEALING POOL =============
+
+/*
+WorkStealingPool(threads) runs parallel_for on `threads` threads in
+total: threads - 1 workers plus the calling thread, which owns deque 0
+while it waits. WorkStealingPool(1) runs everything on the caller.
+
+A job is a range of chunks. A task is a sub-range [first, last) of those
+chunks. Running a task:
+
+    while (last - first > 1) {
+        push [mid, last) to my deque      <- others may steal it
+        last = mid
+    }
+    run chunk `first`
+
+Every task starts at a different chunk, so the tasks of a job live in
+one array indexed by their first chunk: no allocation per task.
+
+Parking: a worker that finds nothing (own deque, then every other deque,
+then a short spin) increments `sleepers`, checks once more, and waits on
+a condition variable until `epoch` changes. Whoever pushes work bumps
+the epoch and notifies only if someone is asleep. The "sleepers++ then
+check" / "push then read sleepers" order (both seq_cst) means either the
+worker sees the task or the pusher sees the sleeper: no lost wake-ups.
+
+parallel_for may be called from one outside thread at a time (others
+wait), and from inside a task (it then uses that worker's deque).
+*/
+class WorkStealingPool {
+    private:
+        struct Job;
+
+        struct Task {
+            Job *job;
+            size_t first, last;  // chunk indices
+        };
+
+        struct Job {
+            size_t n, grain;
+            void (*run)(void *body, size_t begin, size_t end);
+            void *body;
+            vector<Task> tasks;              // tasks[c] = the task starting at chunk c
+            atomic<size_t> remaining{0};     // chunks not finished yet
+        };
+
+        struct alignas(64) Worker {
+            WorkStealingDeque<Task> deque;
+            uint32_t rng;
+        };
+
+        static constexpr int SPINS = 256;
+
+        vector<unique_ptr<Worker>> workers;   // workers[0] = the calling thread
+        vector<thread> threads;
+        mutex callerMutex;                    // one outside caller at a time
+
+        mutex parkMutex;
+        condition_variable parkCv;
+        atomic<uint64_t> epoch{0};
+        atomic<int> sleepers{0};
+        atomic<bool> stopping{false};
+
+        // Which pool/worker the current thread is. Thread-locals start
+        // zeroed, so pool is nullptr on threads outside any pool.
+        struct Current {
+            WorkStealingPool *pool;
+            size_t index;
+        };
+        static inline thread_local Current current;
+
+        void wakeOne() {
+            atomic_thread_fence(memory_order_seq_cst);
+            if (sleepers.load(memory_order_seq_cst) == 0) return;
+            epoch.fetch_add(1, memory_order_seq_cst);
+            { lock_guard<mutex> lock(parkMutex); }
+            parkCv.notify_one();
+        }
+
+        void push(size_t self, Task *task) {
+            workers[self]->deque.push(task);
+            wakeOne();
+        }
+
+        // Own deque first (newest, cache-warm), then steal, starting at a
+        // random victim so thieves do not all hit worker 0
+        Task* findTask(size_t self) {
+            if (Task *t = workers[self]->deque.pop()) return t;
+            size_t count = workers.size();
+            uint32_t &x = workers[self]->rng;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            size_t start = x % count;
+            for (size_t k = 0; k < count; k++) {
+                size_t victim = (start + k) % count;
+                if (victim == self) continue;
+                if (Task *t = workers[victim]->deque.steal()) return t;
+            }
+            return nullptr;
+        }
+
+        bool anyWork() const {
+            for (const auto &w : workers) {
+                if (!w->deque.empty()) return true;
+            }
+            return false;
+        }
+
+        void runTask(size_t self, Task *task) {
+            Job &job = *task->job;
+            size_t first = task->first, last = task->last;
+            while (last - first > 1) {
+                size_t mid = first + (last - first) / 2;
+                job.tasks[mid] = Task{&job, mid, last};
+                push(self, &job.tasks[mid]);
+                last = mid;
+            }
+            size_t begin = first * job.grain;
+            job.run(job.body, begin, min(job.n, begin + job.grain));
+            job.remaining.fetch_sub(1, memory_order_acq_rel);
+        }
+
+        void workerLoop(size_t self) {
+            current = {this, self};
+            while (!stopping.load(memory_order_acquire)) {
+                if (Task *t = findTask(self)) {
+                    runTask(self, t);
+                    continue;
+                }
+                bool found = false;
+                for (int s = 0; s < SPINS && !found; s++) {
+                    cpuRelax();
+                    found = anyWork();
+                }
+                if (found) continue;
+
+                // Park
+                uint64_t seen = epoch.load(memory_order_seq_cst);
+                sleepers.fetch_add(1, memory_order_seq_cst);
+                if (!anyWork()) {
+                    unique_lock<mutex> lock(parkMutex);
+                    parkCv.wait(lock, [&] {
+                        return epoch.load(memory_order_seq_cst) != seen || stopping.load();
+                    });
+                }
+                sleepers.fetch_sub(1, memory_order_seq_cst);
+            }
+        }
+
+        // Runs job to completion on worker `self`, helping with any task
+        // (this job's or another's) while waiting
+        void runJob(size_t self, Job &job) {
+            size_t chunks = job.tasks.size();
+            job.remaining.store(chunks, memory_order_relaxed);
+            job.tasks[0] = Task{&job, 0, chunks};
+            runTask(self, &job.tasks[0]);
+            int idle = 0;
+            while (job.remaining.load(memory_order_acquire) != 0) {
+                if (Task *t = findTask(self)) {
+                    runTask(self, t);
+                    idle = 0;
+                } else if (++idle < SPINS) {
+                    cpuRelax();
+                } else {
+                    this_thread::yield();
+                }
+            }
+        }
+
+        template <typename Body>
+        static void callBody(void *body, size_t begin, size_t end) {
+            (*static_cast<Body*>(body))(begin, end);
+        }
+
+    public:
+        explicit WorkStealingPool(size_t threadCount) {
+            threadCount = max<size_t>(threadCount, 1);
+            for (size_t i = 0; i < threadCount; i++) {
+                workers.push_back(make_unique<Worker>());
+                workers.back()->rng = uint32_t(i * 2654435761u) | 1u;
+            }
+            for (size_t i = 1; i < threadCount; i++) {
+                threads.emplace_back([this, i] { workerLoop(i); });
+            }
+        }
+
+        ~WorkStealingPool() {
+            stopping.store(true, memory_order_release);
+            epoch.fetch_add(1, memory_order_seq_cst);
+            {
+                lock_guard<mutex> lock(parkMutex);
+            }
+            parkCv.notify_all();
+            for (thread &t : threads) t.join();
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        size_t size() const {
+            return workers.size();
+        }
+
+        /*
+        Calls body(begin, end) for the chunks [0, grain), [grain, 2*grain),
+        ... of [0, n) and returns when all of them are done. Which thread
+        runs which chunk varies from run to run; the chunks never do.
+        */
+        template <typename Body>
+        void parallel_for(size_t n, size_t grain, Body body) {
+            if (n == 0) return;
+            grain = max<size_t>(grain, 1);
+            Job job;
+            job.n = n;
+            job.grain = grain;
+            job.run = callBody<Body>;
+            job.body = &body;
+            job.tasks.resize((n + grain - 1) / grain);
+
+            if (current.pool == this) {
+                runJob(current.index, job);
+                return;
+            }
+            lock_guard<mutex> lock(callerMutex);
+            Current saved = current;
+            current = {this, 0};
+            runJob(0, job);
+            current = saved;
+        }
+
+        /*
+        Deterministic reduction: map(begin, end) gives one partial result
+        per chunk, stored in slot chunk-index; the partials are combined
+        left to right on the calling thread. Floating-point sums come out
+        bit-identical for any thread count and any steal pattern.
+        */
+        template <typename T, typename Map, typename Combine>
+        T parallel_reduce(size_t n, size_t grain, T init, Map map, Combine combine) {
+            grain = max<size_t>(grain, 1);
+            vector<T> partial((n + grain - 1) / grain, init);
+            parallel_for(n, grain, [&](size_t begin, size_t end) {
+                partial[begin / grain] = map(begin, end);
+            });
+            T result = init;
+            for (const T &p : partial) result = combine(result, p);
+            return result;
+        }
+};
+
+// ============= THE FLEET =============
+
+/*
+03's Car::accelerate/brake without the printing, stored BY VALUE in one
+vector. subSteps models vehicles that need finer physics (city traffic):
+they cost subSteps times more per tick than highway vehicles.
+*/
+class Vehicle {
+    private:
+        double speed = 0;
+        double odometer = 0;
+        double throttle, brakeForce, maxSpeed;
+        int subSteps;
+
+    public:
+        Vehicle(double throttle, double brakeForce, double maxSpeed, int subSteps)
+            : throttle(throttle), brakeForce(brakeForce), maxSpeed(maxSpeed), subSteps(subSteps) {}
+
+        void accelerate(double amount) {
+            speed += amount;
+            if (speed > maxSpeed) speed = maxSpeed;
+        }
+
+        void brake(double amount) {
+            speed -= amount;
+            if (speed < 0) speed = 0;
+        }
+
+        void step(double hours) {
+            double dt = hours / subSteps;
+            for (int s = 0; s < subSteps; s++) {
+                accelerate(throttle / subSteps);
+                brake(brakeForce / subSteps);
+                odometer += speed * dt;
+            }
+        }
+
+        double getOdometer() const { return odometer; }
+};
+
+// ============= BENCHMARK =============
+
+template <typename Body>
+double timeMs(Body body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// cityShare of the fleet (all at the front, like vehicles sorted by
+// region) needs citySteps sub-steps; the rest needs 1
+vector<Vehicle> makeFleet(size_t n, double cityShare, int citySteps) {
+    mt19937 rng(42);
+    uniform_real_distribution<double> input(0, 10);
+    vector<Vehicle> fleet;
+    fleet.reserve(n);
+    size_t city = size_t(double(n) * cityShare);
+    for (size_t i = 0; i < n; i++) {
+        double throttle = input(rng), brakeForce = input(rng);
+        fleet.emplace_back(throttle, brakeForce, i % 2 ? 200 : 150, i < city ? citySteps : 1);
+    }
+    return fleet;
+}
+
+double totalDistance(WorkStealingPool &pool, const vector<Vehicle> &fleet) {
+    return pool.parallel_reduce(fleet.size(), 4096, 0.0,
+        [&](size_t begin, size_t end) {
+            double sum = 0;
+            for (size_t i = begin; i < end; i++) sum += fleet[i].getOdometer();
+            return sum;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+// Steps the fleet `ticks` times; grain = vehicles per chunk
+double stepFleet(WorkStealingPool &pool, vector<Vehicle> &fleet, int ticks, size_t grain) {
+    const double hours = 1.0 / 3600;
+    return timeMs([&] {
+        for (int t = 0; t < ticks; t++) {
+            pool.parallel_for(fleet.size(), grain, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) fleet[i].step(hours);
+            });
+        }
+    });
+}
+
+void benchmark(size_t n, int ticks, size_t maxThreads) {
+    vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    struct Workload {
+        const char *name;
+        double cityShare;
+        int citySteps;
+    };
+    for (Workload w : {Workload{"uniform (every vehicle 1 sub-step)", 0, 1},
+                       Workload{"uneven (first 1/8 of the fleet 32 sub-steps)", 0.125, 32}}) {
+        cout << "\n--- BENCHMARK: " << n << " vehicles, " << ticks << " ticks, " << w.name << " ---\n";
+        double base = 0, reference = 0;
+        bool reproducible = true;
+        for (size_t threads : threadCounts) {
+            WorkStealingPool pool(threads);
+
+            // One chunk per thread: what a static split (12_Parallel_Sort's
+            // parallelFor) does. Nothing is left to steal once a thread is done.
+            vector<Vehicle> fleet = makeFleet(n, w.cityShare, w.citySteps);
+            double staticMs = stepFleet(pool, fleet, ticks, (n + threads - 1) / threads);
+
+            // Small chunks: idle threads steal what is left
+            vector<Vehicle> stealingFleet = makeFleet(n, w.cityShare, w.citySteps);
+            double stealMs = stepFleet(pool, stealingFleet, ticks, 4096);
+
+            double distance = totalDistance(pool, stealingFleet);
+            if (threads == 1) {
+                base = stealMs;
+                reference = distance;
+            }
+            reproducible &= distance == reference;
+
+            cout << "  " << threads << " thread(s): static split " << staticMs / ticks << " ms/tick, "
+                 << "work stealing " << stealMs / ticks << " ms/tick (" << ticks * 1000.0 / stealMs
+                 << " ticks/s, speedup x" << base / stealMs << ")\n";
+        }
+        cout << "  total distance " << reference << " km, identical for every thread count: "
+             << boolalpha << reproducible << "\n";
+    }
+}
+
+// ============= MAIN FUNCTION =============
+
+int main(int argc, char **argv) {
+    cout << "========================================\n";
+    cout << "  WORK-STEALING THREAD POOL\n";
+    cout << "========================================\n";
+
+    size_t hw = max(1u, thread::hardware_concurrency());
+
+    // ===== PARALLEL FOR =====
+    cout << "\n--- parallel_for over a small fleet ---\n";
+    WorkStealingPool pool(hw);
+    vector<Vehicle> fleet = makeFleet(10, 0.5, 4);
+    pool.parallel_for(fleet.size(), 3, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) fleet[i].step(1.0);
+    });
+    for (const Vehicle &v : fleet) cout << v.getOdometer() << " ";
+    cout << "\n";
+
+    // ===== DETERMINISTIC REDUCTION =====
+    cout << "\n--- parallel_reduce, same result on any thread count ---\n";
+    vector<double> values(1000000);
+    for (size_t i = 0; i < values.size(); i++) values[i] = 1.0 / double(i + 1);
+    auto harmonic = [&](WorkStealingPool &p) {
+        return p.parallel_reduce(values.size(), 1000, 0.0,
+            [&](size_t begin, size_t end) {
+                double sum = 0;
+                for (size_t i = begin; i < end; i++) sum += values[i];
+                return sum;
+            },
+            [](double a, double b) { return a + b; });
+    };
+    WorkStealingPool single(1);
+    cout.precision(17);
+    cout << "1 thread : " << harmonic(single) << "\n";
+    cout << hw << (hw == 1 ? " thread : " : " threads: ") << harmonic(pool) << "\n";
+    cout.precision(6);
+
+    // ===== NESTED PARALLELISM =====
+    cout << "\n--- parallel_for inside parallel_for ---\n";
+    atomic<size_t> cells{0};
+    pool.parallel_for(8, 1, [&](size_t, size_t) {
+        pool.parallel_for(1000, 100, [&](size_t begin, size_t end) {
+            cells.fetch_add(end - begin, memory_order_relaxed);
+        });
+    });
+    cout << "8 x 1000 = " << cells.load() << "\n";
+
+    // ===== BENCHMARK =====
+    // ./steal 2000000 20 [max threads]
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 20;
+    size_t maxThreads = argc > 3 ? max<size_t>(1, strtoull(argv[3], nullptr, 10)) : hw;
+    benchmark(n, ticks, maxThreads);
+
+    cout << "\n========================================\n";
+    cout << "  Tutorial Complete!\n";
+    cout << "========================================\n";
+
+    return 0;
+}
+
+/*
+KEY CONCEPTS:
+
+1. ONE DEQUE PER THREAD:
+   - Owner pushes/pops at the bottom: no contention in the common case
+   - Thieves CAS the top: they take the oldest (largest) work
+   - Growing the buffer: copy, keep the old one alive for slow thieves
+
+2. RECURSIVE SPLITTING:
+   - One task for the whole range; split in half, push the right half
+   - Steals move big ranges, so a few steals balance the whole job
+   - Tasks indexed by their first chunk: no allocation per task
+
+3. PARKING:
+   - Spin briefly (work often shows up within microseconds)
+   - Then sleep on a condition variable; pushers wake one sleeper
+   - sleepers++/re-check vs push/read-sleepers: no lost wake-ups
+
+4. DETERMINISM:
+   - Chunk boundaries depend on n and grain only
+   - One partial result per chunk, combined in chunk order
+   - Same floating-point result on 1 thread or many
+
+5. STATIC SPLIT vs STEALING:
+   - Equal work: both scale the same
+   - Uneven work: a static split waits for the slowest chunk;
+     stealing keeps every thread busy until the end
+
+COMPILATION:
+    g++ -std=c++17 -O2 -pthread 27_Work_Stealing_Pool.cpp -o steal && ./steal
+    ./steal 2000000 20 8   (vehicles, ticks, max threads)
+
+NEXT STEP: Profile the fleet with perf and find the next bottleneck!
+*/
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include <vector>
 using namespace std;
 
 // ============================================================================
@@ -200,12 +201,12 @@ void arrays() {
     }
     cout << endl;
     
-    // Variable Length Array (VLA) - Note: Not standard C++, compiler extension
+    // Runtime-sized array - int arr5[n] (a VLA) is not standard C++, only a compiler extension
     int n;
     cin >> n;
-    int arr5[n];  // Variable length array
-    // Alternative: Dynamic allocation
-    // int *arrVLA = new int[n];
+    vector<int> arr5(n);  // Standard replacement for the VLA
+    // For sizes that are usually small, small_vector keeps them off the heap
+    // (see 18_Small_Vector.cpp)
     
     // Range-based for loop (C++11)
     int arr3[] = {1, 2, 3, 4};